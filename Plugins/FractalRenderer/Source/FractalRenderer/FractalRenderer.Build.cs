@@ -25,7 +25,7 @@ public class FractalRenderer : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[]
 		{
-			// ... add private dependencies that you statically link with here ...
+			"ImageCore"
 		});
 
 		if (Target.bBuildEditor == true)
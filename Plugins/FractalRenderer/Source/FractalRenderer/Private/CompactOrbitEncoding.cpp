@@ -0,0 +1,241 @@
+#include "CompactOrbitEncoding.h"
+#include "MandelbulbOrbitGenerator.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "FractalStats.h"
+#include "FractalBenchmarkArgs.h"
+#include <cmath>
+
+DEFINE_LOG_CATEGORY_STATIC(LogCompactOrbitEncoding, Log, All);
+
+namespace
+{
+	constexpr uint32 ComponentMask = (1u << FCompactOrbitEncoding::BitsPerComponent) - 1;
+
+	// x in bits 0-20 of the first word, y split over bits 21-31 and 0-9 of the second, z in bits 10-30
+	FORCEINLINE FUintVector2 PackQuantized(int32 X, int32 Y, int32 Z)
+	{
+		const uint32 UX = static_cast<uint32>(X) & ComponentMask;
+		const uint32 UY = static_cast<uint32>(Y) & ComponentMask;
+		const uint32 UZ = static_cast<uint32>(Z) & ComponentMask;
+		return FUintVector2(UX | (UY << 21), (UY >> 11) | (UZ << 10));
+	}
+
+	FORCEINLINE int32 SignExtend(uint32 Value)
+	{
+		constexpr int32 Shift = 32 - FCompactOrbitEncoding::BitsPerComponent;
+		return static_cast<int32>(Value << Shift) >> Shift;
+	}
+}
+
+void FCompactOrbitEncoding::Encode(const FReferenceOrbit& Orbit)
+{
+	FRACTAL_TRACE_SCOPE(FCompactOrbitEncoding::Encode);
+
+	Reset();
+	NumPoints = Orbit.GetLength();
+
+	const int32 NumBlocks = FMath::DivideAndRoundUp(NumPoints, PointsPerBlock);
+	Blocks.SetNumUninitialized(NumBlocks);
+	Positions.SetNumZeroed(NumBlocks * PointsPerBlock);
+	Scales.SetNumZeroed(NumBlocks * PointsPerBlock);
+
+	const TConstArrayView<FVector3f> GpuDerivatives = Orbit.GetGpuDerivatives();
+
+	for (int32 Block = 0; Block < NumBlocks; ++Block)
+	{
+		const int32 First = Block * PointsPerBlock;
+		const int32 Last = FMath::Min(First + PointsPerBlock, NumPoints);
+
+		FVector3d Min(TNumericLimits<double>::Max());
+		FVector3d Max(TNumericLimits<double>::Lowest());
+		for (int32 Index = First; Index < Last; ++Index)
+		{
+			const FVector3d Position = Orbit.GetPosition(Index);
+			Min = Min.ComponentMin(Position);
+			Max = Max.ComponentMax(Position);
+		}
+
+		// Offsets are taken from the float origin the shader sees, so its rounding is not part of the error
+		const FVector3f Origin((Min + Max) * 0.5);
+		const FVector3d OriginD(Origin);
+		const double HalfExtent = FMath::Max((Max - OriginD).GetAbs().GetMax(), (Min - OriginD).GetAbs().GetMax());
+
+		// Smallest float step that still reaches the block's extent with MaxQuantizedMagnitude steps
+		float Step = HalfExtent > 0.0 ? FMath::Max(static_cast<float>(HalfExtent / MaxQuantizedMagnitude), FLT_MIN) : 1.0f;
+		while (HalfExtent / Step > MaxQuantizedMagnitude)
+		{
+			Step = std::nextafter(Step, TNumericLimits<float>::Max());
+		}
+		Blocks[Block] = FVector4f(Origin, Step);
+
+		for (int32 Index = First; Index < Last; ++Index)
+		{
+			const FVector3d Offset = (Orbit.GetPosition(Index) - OriginD) / Step;
+			Positions[Index] = PackQuantized(
+				static_cast<int32>(FMath::Clamp<int64>(FMath::RoundToInt64(Offset.X), -MaxQuantizedMagnitude, MaxQuantizedMagnitude)),
+				static_cast<int32>(FMath::Clamp<int64>(FMath::RoundToInt64(Offset.Y), -MaxQuantizedMagnitude, MaxQuantizedMagnitude)),
+				static_cast<int32>(FMath::Clamp<int64>(FMath::RoundToInt64(Offset.Z), -MaxQuantizedMagnitude, MaxQuantizedMagnitude)));
+			Scales[Index] = GpuDerivatives[Index].Y;
+		}
+	}
+}
+
+FVector3f FCompactOrbitEncoding::DecodePosition(int32 Index) const
+{
+	check(Index >= 0 && Index < NumPoints);
+	const FUintVector2& Packed = Positions[Index];
+	const FVector4f& Block = Blocks[Index / PointsPerBlock];
+
+	const int32 X = SignExtend(Packed.X & ComponentMask);
+	const int32 Y = SignExtend(((Packed.X >> 21) | (Packed.Y << 11)) & ComponentMask);
+	const int32 Z = SignExtend((Packed.Y >> 10) & ComponentMask);
+	return FVector3f(
+		Block.X + static_cast<float>(X) * Block.W,
+		Block.Y + static_cast<float>(Y) * Block.W,
+		Block.Z + static_cast<float>(Z) * Block.W);
+}
+
+double FCompactOrbitEncoding::GetErrorBound(int32 Index) const
+{
+	check(Index >= 0 && Index < NumPoints);
+	const double Step = Blocks[Index / PointsPerBlock].W;
+
+	// Per component: half a step of quantization, then one rounding each for q * step and the add
+	const double Rounding = 0.5 * FLT_EPSILON * (MaxQuantizedMagnitude * Step + DecodePosition(Index).GetAbsMax());
+	return UE_SQRT_3 * (0.5 * Step + Rounding);
+}
+
+void FCompactOrbitEncoding::Reset()
+{
+	Blocks.Reset();
+	Positions.Reset();
+	Scales.Reset();
+	NumPoints = 0;
+}
+
+namespace
+{
+	// DERIVATIVE_REUSE_TOLERANCE in PerturbationShader.usf
+	constexpr double DerivativeReuseTolerance = 0.01;
+
+	/** One orbit point as a shader encoding provides it: Z_n, p*|Z_n|^(p-1) and |Z_n|. */
+	struct FOrbitSample
+	{
+		FVector3d Position;
+		double Scale;
+		double Radius;
+	};
+
+	/**
+	 * MandelbulbPerturbationDE without series skip or convergence exit, with the orbit read through
+	 * LoadSample so different encodings of one orbit can be compared. Returns false if the sample stays
+	 * bounded for the whole orbit, where the DE carries no surface information.
+	 */
+	template <typename LoadSampleType>
+	bool EstimatePerturbedDistance(const FVector3d& Position, double Power, int32 OrbitLength, double BailoutRadius, LoadSampleType&& LoadSample, double& OutDistance)
+	{
+		FOrbitSample Reference = LoadSample(0);
+		FVector3d Epsilon = FVector3d::ZeroVector;
+		double Derivative = 1.0;
+		for (int32 Iteration = 0; Iteration + 1 < OrbitLength; ++Iteration)
+		{
+			const FVector3d ZActual = Reference.Position + Epsilon;
+			const double Radius = ZActual.Length();
+			if (Radius > BailoutRadius)
+			{
+				OutDistance = 0.5 * FMath::Loge(Radius) * Radius / Derivative;
+				return true;
+			}
+
+			// DerivativeScale in the shader: the stored scale with a first-order radius correction near the reference
+			const double SafeRadius = FMath::Max(Radius, 1e-6);
+			const double RelativeDelta = (SafeRadius - Reference.Radius) / FMath::Max(Reference.Radius, 1e-6);
+			const double Scale = FMath::Abs(RelativeDelta) < DerivativeReuseTolerance
+				? Reference.Scale * (1.0 + (Power - 1.0) * RelativeDelta)
+				: Power * FMath::Pow(SafeRadius, Power - 1.0);
+			Derivative = Scale * Derivative + 1.0;
+
+			const FOrbitSample Next = LoadSample(Iteration + 1);
+			Epsilon = MandelbulbMath::TrigPowerMap(ZActual, Power) + Position - Next.Position;
+			Reference = Next;
+		}
+		return false;
+	}
+}
+
+TOptional<double> FCompactOrbitEncoding::GetRelativeDistanceError(const FReferenceOrbit& Orbit, const FVector3d& Position) const
+{
+	const double Power = Orbit.Power;
+	const auto LoadDouble = [&Orbit, Power](int32 Index)
+	{
+		const FVector3d Z = Orbit.GetPosition(Index);
+		const double Radius = Z.Length();
+		return FOrbitSample{ Z, Power * FMath::Pow(FMath::Max(Radius, 1e-6), Power - 1.0), Radius };
+	};
+	const auto LoadCompact = [this](int32 Index)
+	{
+		const FVector3d Z(DecodePosition(Index));
+		return FOrbitSample{ Z, Scales[Index], Z.Length() };
+	};
+
+	double Distance;
+	if (!EstimatePerturbedDistance(Position, Power, NumPoints, Orbit.BailoutRadius, LoadDouble, Distance) || Distance <= 0.0)
+	{
+		return TOptional<double>();
+	}
+
+	// A decoded orbit that keeps the sample bounded is as wrong as it gets
+	double EncodedDistance;
+	return EstimatePerturbedDistance(Position, Power, NumPoints, Orbit.BailoutRadius, LoadCompact, EncodedDistance)
+		? FMath::Abs(EncodedDistance - Distance) / Distance
+		: 1.0;
+}
+
+namespace
+{
+	/**
+	 * Fractal.BenchmarkOrbitEncoding [Iterations] [Power] [Orbits]
+	 * Encodes random orbits compactly and reports the encoding's size against the float3 buffers and the
+	 * former float4 textures, and its encode time. Fractal.Orbit.CompactEncodingAccuracy (automation) checks its accuracy.
+	 */
+	void BenchmarkOrbitEncoding(const TArray<FString>& InArgs)
+	{
+		const FFractalOrbitBenchmarkArgs Args(InArgs, 100000, 8);
+		const double BailoutRadius = 2.0;
+
+		const FMandelbulbOrbitGenerator Generator;
+		FRandomStream Stream(1337);
+
+		int64 NumPoints = 0;
+		double EncodeSeconds = 0.0;
+		for (int32 OrbitIndex = 0; OrbitIndex < Args.NumOrbits; ++OrbitIndex)
+		{
+			// Centers near the origin stay bounded, which is where long orbits come from
+			const FVector3d Center(Stream.FRandRange(-0.6, 0.6), Stream.FRandRange(-0.6, 0.6), Stream.FRandRange(-0.6, 0.6));
+			const FReferenceOrbit Orbit = Generator.GenerateOrbit(Center, Args.Power, Args.MaxIterations, BailoutRadius);
+
+			FCompactOrbitEncoding Encoding;
+			const double StartTime = FPlatformTime::Seconds();
+			Encoding.Encode(Orbit);
+			EncodeSeconds += FPlatformTime::Seconds() - StartTime;
+			NumPoints += Encoding.Num();
+		}
+
+		const double FloatBytesPerPoint = 2.0 * sizeof(FVector3f);
+		const double TextureBytesPerPoint = 2.0 * sizeof(FVector4f);
+		UE_LOG(LogCompactOrbitEncoding, Display,
+			TEXT("Fractal.BenchmarkOrbitEncoding: %d orbits, %lld points. %.2f bytes/point vs %.0f (float3 buffers, %.2fx) and %.0f (float4 textures, %.2fx), encode %.2f ms per million points"),
+			Args.NumOrbits, NumPoints,
+			FCompactOrbitEncoding::BytesPerPoint,
+			FloatBytesPerPoint, FloatBytesPerPoint / FCompactOrbitEncoding::BytesPerPoint,
+			TextureBytesPerPoint, TextureBytesPerPoint / FCompactOrbitEncoding::BytesPerPoint,
+			EncodeSeconds * 1000.0 * 1e6 / FMath::Max<int64>(NumPoints, 1));
+	}
+
+	FAutoConsoleCommand BenchmarkOrbitEncodingCommand(
+		TEXT("Fractal.BenchmarkOrbitEncoding"),
+		TEXT("Report the compact orbit encoding's size and encode time. Args: [Iterations=100000] [Power=8] [Orbits=8]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkOrbitEncoding));
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MandelbulbMath.h"
+
+/** [Iterations] [Power] [Orbits] of the Fractal.Benchmark* orbit commands, each falling back to the command's default. */
+struct FFractalOrbitBenchmarkArgs
+{
+	int32 MaxIterations;
+	double Power;
+	int32 NumOrbits;
+
+	FFractalOrbitBenchmarkArgs(const TArray<FString>& Args, int32 DefaultIterations, int32 DefaultOrbits)
+		: MaxIterations(Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : DefaultIterations)
+		, Power(Args.Num() > 1 ? FCString::Atod(*Args[1]) : 8.0)
+		, NumOrbits(Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : DefaultOrbits)
+	{
+	}
+
+	// The polynomial paths the commands time exist for integer powers MinPolynomialPower..MaxPolynomialPower only
+	bool HasPolynomialPower() const
+	{
+		return MandelbulbMath::GetPolynomialPower(Power) != 0;
+	}
+
+	FString DescribeUnsupportedPower(const TCHAR* Command) const
+	{
+		return FString::Printf(TEXT("%s: power %.3f has no polynomial specialization (supported: %d..%d)"),
+			Command, Power, MandelbulbMath::MinPolynomialPower, MandelbulbMath::MaxPolynomialPower);
+	}
+};
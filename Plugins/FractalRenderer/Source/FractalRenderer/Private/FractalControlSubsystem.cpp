@@ -2,22 +2,329 @@
 #include "FractalRenderer.h"
 #include "FractalSceneViewExtension.h"
 #include "MandelbulbOrbitGenerator.h"
+#include "PerturbationShader.h"
+#include "FractalStats.h"
 #include "Math/UnrealMathUtility.h"
 #include "Engine/Engine.h"
+#include "Tasks/Task.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include <atomic>
 
 DEFINE_LOG_CATEGORY_STATIC(LogFractalControl, Log, All);
 
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Orbit Job Time (ms)"), STAT_FractalOrbitJobMs, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Orbit Publish Time (ms)"), STAT_FractalOrbitPublishMs, STATGROUP_Fractal);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Orbit Length"), STAT_FractalOrbitLength, STATGROUP_Fractal);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Reference Orbits"), STAT_FractalNumReferences, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Orbit Regenerations / s"), STAT_FractalOrbitRegenerationsPerSecond, STATGROUP_Fractal);
+
+TRACE_DECLARE_INT_COUNTER(FractalOrbitLength, TEXT("Fractal/Orbit Length"));
+TRACE_DECLARE_FLOAT_COUNTER(FractalOrbitRegenerationsPerSecond, TEXT("Fractal/Orbit Regenerations per Second"));
+
+namespace
+{
+	// Below this zoom, Auto orbit precision switches from double to double-double
+	constexpr double ExtendedPrecisionZoomThreshold = 1e-10;
+
+	// Center drift (relative to zoom) that triggers a new reference orbit; also the orbit cache grid size
+	constexpr double OrbitCenterThreshold = 0.01;
+
+	TAutoConsoleVariable<int32> CVarReferenceSearchCandidatesPerAxis(
+		TEXT("Fractal.ReferenceSearch.CandidatesPerAxis"),
+		5,
+		TEXT("Candidate reference centers per axis searched around the view center for the longest-surviving orbit (0 or 1 uses the view center)."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarOrbitCacheBudgetMB(
+		TEXT("Fractal.OrbitCache.BudgetMB"),
+		128.0f,
+		TEXT("Memory budget in MB for cached reference orbits (LRU eviction). 0 disables the cache."),
+		ECVF_Default);
+
+	// Glitch clusters are grouped within this fraction of the reported samples' bounding-box diagonal
+	constexpr double GlitchClusterRadiusFraction = 0.25;
+
+	// Fewer glitched samples than this around a seed are treated as noise rather than a cluster
+	constexpr int32 MinGlitchClusterSize = 4;
+
+	TAutoConsoleVariable<int32> CVarGlitchMinPixels(
+		TEXT("Fractal.Glitch.MinPixels"),
+		16,
+		TEXT("Glitched pixels per frame below which no secondary reference orbits are generated."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarGlitchMaxSecondaryReferences(
+		TEXT("Fractal.Glitch.MaxSecondaryReferences"),
+		FRACTAL_MAX_REFERENCES - 1,
+		TEXT("Secondary reference orbits placed on glitch clusters per primary orbit (0 disables, capped by the shader)."),
+		ECVF_Default);
+
+	/**
+	 * Picks up to MaxCenters reference centers on clusters of glitched samples. Clusters are grown
+	 * greedily from the densest remaining sample, and each gets a reference on its sample nearest
+	 * the centroid, so the new orbit starts inside the glitch. Clusters an existing reference already
+	 * sits in are skipped.
+	 */
+	TArray<FVector3d> SelectGlitchReferenceCenters(const TArray<FVector3f>& Samples, int32 MaxCenters, const TArray<FVector3d>& ExistingCenters)
+	{
+		TArray<FVector3d> Centers;
+		if (Samples.Num() == 0 || MaxCenters <= 0)
+		{
+			return Centers;
+		}
+
+		FBox3d Bounds(ForceInit);
+		for (const FVector3f& Sample : Samples)
+		{
+			Bounds += FVector3d(Sample);
+		}
+		const double ClusterRadiusSq = FMath::Square(FMath::Max(Bounds.GetSize().Length() * GlitchClusterRadiusFraction, UE_DOUBLE_SMALL_NUMBER));
+
+		TArray<bool> Assigned;
+		Assigned.Init(false, Samples.Num());
+		while (Centers.Num() < MaxCenters)
+		{
+			// Densest unassigned sample seeds the next cluster (at most a few hundred samples, so O(n^2) is fine)
+			int32 Seed = INDEX_NONE;
+			int32 SeedCount = 0;
+			for (int32 Index = 0; Index < Samples.Num(); ++Index)
+			{
+				if (Assigned[Index])
+				{
+					continue;
+				}
+
+				int32 Count = 0;
+				for (int32 Other = 0; Other < Samples.Num(); ++Other)
+				{
+					Count += (!Assigned[Other] && FVector3f::DistSquared(Samples[Index], Samples[Other]) <= ClusterRadiusSq) ? 1 : 0;
+				}
+				if (Count > SeedCount)
+				{
+					Seed = Index;
+					SeedCount = Count;
+				}
+			}
+
+			if (Seed == INDEX_NONE || SeedCount < MinGlitchClusterSize)
+			{
+				break;
+			}
+
+			TArray<int32> Members;
+			FVector3d Centroid = FVector3d::ZeroVector;
+			for (int32 Index = 0; Index < Samples.Num(); ++Index)
+			{
+				if (!Assigned[Index] && FVector3f::DistSquared(Samples[Seed], Samples[Index]) <= ClusterRadiusSq)
+				{
+					Members.Add(Index);
+					Centroid += FVector3d(Samples[Index]);
+					Assigned[Index] = true;
+				}
+			}
+			Centroid /= Members.Num();
+
+			FVector3d Chosen = FVector3d(Samples[Members[0]]);
+			for (int32 Member : Members)
+			{
+				if (FVector3d::DistSquared(FVector3d(Samples[Member]), Centroid) < FVector3d::DistSquared(Chosen, Centroid))
+				{
+					Chosen = FVector3d(Samples[Member]);
+				}
+			}
+
+			const auto IsCovered = [&Chosen, ClusterRadiusSq](const FVector3d& Center)
+			{
+				return FVector3d::DistSquared(Center, Chosen) <= 0.25 * ClusterRadiusSq;
+			};
+			if (!ExistingCenters.ContainsByPredicate(IsCovered) && !Centers.ContainsByPredicate(IsCovered))
+			{
+				Centers.Add(Chosen);
+			}
+		}
+
+		return Centers;
+	}
+
+	TAutoConsoleVariable<int32> CVarGovernorEnable(
+		TEXT("Fractal.Governor.Enable"),
+		1,
+		TEXT("Scale MaxRaySteps, MaxIterations, MinIterations and ConvergenceFactor with the measured GPU time of the fractal passes (0 renders the configured values)."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarGovernorTargetMs(
+		TEXT("Fractal.Governor.TargetMs"),
+		10.0f,
+		TEXT("GPU time in milliseconds the governor holds the fractal passes (cone prepass and main pass) to."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarGovernorHysteresis(
+		TEXT("Fractal.Governor.Hysteresis"),
+		0.15f,
+		TEXT("Relative band around the target within which the budgets are left alone."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarGovernorMinQuality(
+		TEXT("Fractal.Governor.MinQuality"),
+		0.25f,
+		TEXT("Lowest fraction of the configured budgets the governor may go down to."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarGovernorMinResolution(
+		TEXT("Fractal.Governor.MinResolution"),
+		0.5f,
+		TEXT("Lowest fraction of the configured screen percentage (per axis) the governor trades away before it lowers step and iteration budgets (1 keeps the resolution)."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarGovernorRecoveryStep(
+		TEXT("Fractal.Governor.RecoveryStep"),
+		0.05f,
+		TEXT("Fraction of the configured budgets regained per decision while under the band."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarGovernorCooldown(
+		TEXT("Fractal.Governor.Cooldown"),
+		10,
+		TEXT("GPU time samples after a change before the governor decides again; covers the frames its timings take to arrive."),
+		ECVF_Default);
+
+	// Grid references are only placed where rays cross this sphere around the origin, which bounds the Mandelbulb
+	constexpr double ReferenceGridBoundsRadius = 1.5;
+
+	// The grid is regenerated once a desired center moves more than this fraction of the grid spacing
+	constexpr double ReferenceGridRefreshFraction = 0.25;
+
+	TAutoConsoleVariable<int32> CVarReferenceGridResolution(
+		TEXT("Fractal.ReferenceGrid.Resolution"),
+		2,
+		TEXT("Screen-space rays per axis along which grid reference orbits are placed (0 disables the grid)."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarReferenceGridDepthSlices(
+		TEXT("Fractal.ReferenceGrid.DepthSlices"),
+		2,
+		TEXT("Grid reference orbits placed along each grid ray, evenly spread over its marched segment."),
+		ECVF_Default);
+
+	/**
+	 * Places reference centers on an NxN grid of screen rays, DepthSlices per ray, spread over the part of
+	 * each ray that is both marched (MaxRayDistance) and inside the fractal's bounding sphere. Returns
+	 * centers in fractal space; rays that miss the sphere contribute none.
+	 */
+	TArray<FVector3d> ComputeGridReferenceCenters(const FFractalViewFrustum& Frustum, const FFractalParameter& Params, int32 Resolution, int32 DepthSlices, int32 MaxCenters)
+	{
+		TArray<FVector3d> Centers;
+		const double Zoom = FMath::Max(static_cast<double>(Params.Zoom), UE_DOUBLE_SMALL_NUMBER);
+		const FVector3d Origin = FVector3d(Params.Center.X, Params.Center.Y, 0.0) + Frustum.Origin * Zoom;
+		const double MaxDistance = static_cast<double>(Params.MaxRayDistance) * Zoom;
+
+		for (int32 Y = 0; Y < Resolution; ++Y)
+		{
+			for (int32 X = 0; X < Resolution; ++X)
+			{
+				const double NdcX = (X + 0.5) / Resolution * 2.0 - 1.0;
+				const double NdcY = 1.0 - (Y + 0.5) / Resolution * 2.0;
+				const FVector3d Direction = Frustum.GetRayDirection(NdcX, NdcY).GetSafeNormal();
+
+				// Ray/sphere intersection, clipped to the marched distance
+				const double B = FVector3d::DotProduct(Origin, Direction);
+				const double C = Origin.SizeSquared() - FMath::Square(ReferenceGridBoundsRadius);
+				const double Discriminant = B * B - C;
+				if (Discriminant <= 0.0)
+				{
+					continue;
+				}
+				const double Near = FMath::Max(-B - FMath::Sqrt(Discriminant), 0.0);
+				const double Far = FMath::Min(-B + FMath::Sqrt(Discriminant), MaxDistance);
+				if (Far <= Near)
+				{
+					continue;
+				}
+
+				for (int32 Slice = 0; Slice < DepthSlices && Centers.Num() < MaxCenters; ++Slice)
+				{
+					Centers.Add(Origin + Direction * FMath::Lerp(Near, Far, (Slice + 0.5) / DepthSlices));
+				}
+			}
+		}
+
+		return Centers;
+	}
+
+	// Whether every desired grid center is still close to the one generated for it
+	bool IsReferenceGridCurrent(const TArray<FVector3d>& Desired, const TArray<FVector3d>& Current)
+	{
+		if (Desired.Num() != Current.Num())
+		{
+			return false;
+		}
+		if (Desired.Num() == 0)
+		{
+			return true;
+		}
+
+		FBox3d Bounds(Desired);
+		const double Spacing = Bounds.GetSize().Length() / FMath::Max(FMath::Sqrt(static_cast<double>(Desired.Num())), 1.0);
+		const double ToleranceSq = FMath::Square(FMath::Max(Spacing * ReferenceGridRefreshFraction, UE_DOUBLE_SMALL_NUMBER));
+		for (int32 Index = 0; Index < Desired.Num(); ++Index)
+		{
+			if (FVector3d::DistSquared(Desired[Index], Current[Index]) > ToleranceSq)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	EFractalOrbitPrecision ResolveOrbitPrecision(const FFractalParameter& Params)
+	{
+		if (Params.OrbitPrecision != EFractalOrbitPrecision::Auto)
+		{
+			return Params.OrbitPrecision;
+		}
+		return Params.Zoom < ExtendedPrecisionZoomThreshold ? EFractalOrbitPrecision::DoubleDouble : EFractalOrbitPrecision::Double;
+	}
+}
+
+/**
+ * State shared between the subsystem and its background orbit jobs.
+ * Jobs compare their version against LatestRequestedVersion to detect that they are stale.
+ */
+struct FOrbitGenerationJobState
+{
+	std::atomic<uint64> LatestRequestedVersion{0};
+
+	FCriticalSection ResultMutex;
+	TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe> CompletedOrbit;
+	FOrbitCacheKey CompletedKey;
+	uint64 CompletedVersion = 0;
+	double CompletedSeconds = 0.0;  // Wall time the job took, including the reference center search
+
+	// Secondary orbits, tagged with the primary version they were placed for
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> CompletedSecondaryOrbits;
+	uint64 CompletedSecondaryVersion = 0;
+	bool bHasCompletedSecondaryOrbits = false;
+
+	// Grid orbits and the centers they were requested at, tagged with the primary version they were placed for
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> CompletedGridOrbits;
+	TArray<FVector3d> CompletedGridCenters;
+	uint64 CompletedGridVersion = 0;
+	bool bHasCompletedGridOrbits = false;
+};
+
 void UFractalControlSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
-	// Create orbit generator
-	OrbitGenerator = MakeUnique<FMandelbulbOrbitGenerator>();
+	// Create orbit generator and the hand-off slot used by background jobs
+	OrbitGenerator = MakeShared<FMandelbulbOrbitGenerator, ESPMode::ThreadSafe>();
+	OrbitJobState = MakeShared<FOrbitGenerationJobState, ESPMode::ThreadSafe>();
 
 	// Default values are set by the FFractalParameter constructor
 	UE_LOG(LogFractalControl, Log, TEXT("FractalControlSubsystem: Initialized"));
 
-	// Generate initial reference orbit
+	// Start generating the initial reference orbit (published from Tick once ready)
 	GenerateReferenceOrbit();
 
 	// Set initial parameters
@@ -26,10 +333,363 @@ void UFractalControlSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UFractalControlSubsystem::Deinitialize()
 {
+	// Cancel any in-flight job; it holds its own references to the generator and job state
+	if (OrbitJobState.IsValid())
+	{
+		OrbitJobState->LatestRequestedVersion.store(MAX_uint64);
+	}
+
+	OrbitJobState.Reset();
 	OrbitGenerator.Reset();
+	OrbitCache.Empty();
+	CurrentOrbit.Reset();
+	GridOrbits.Reset();
+	SecondaryOrbits.Reset();
 	Super::Deinitialize();
 }
 
+void UFractalControlSubsystem::Tick(float DeltaTime)
+{
+	if (!OrbitJobState.IsValid())
+	{
+		return;
+	}
+
+	TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe> CompletedOrbit;
+	FOrbitCacheKey CompletedKey;
+	uint64 CompletedVersion = 0;
+	double CompletedSeconds = 0.0;
+	{
+		FScopeLock Lock(&OrbitJobState->ResultMutex);
+		if (OrbitJobState->CompletedVersion > PublishedOrbitVersion)
+		{
+			CompletedOrbit = MoveTemp(OrbitJobState->CompletedOrbit);
+			CompletedKey = OrbitJobState->CompletedKey;
+			CompletedVersion = OrbitJobState->CompletedVersion;
+			CompletedSeconds = OrbitJobState->CompletedSeconds;
+		}
+	}
+
+	if (CompletedOrbit.IsValid())
+	{
+		PipelineStats.OrbitGenerationMs = static_cast<float>(CompletedSeconds * 1000.0);
+		SET_FLOAT_STAT(STAT_FractalOrbitJobMs, PipelineStats.OrbitGenerationMs);
+		OrbitCache.SetBudgetBytes(GetOrbitCacheBudgetBytes());
+		OrbitCache.Add(CompletedKey, CompletedOrbit);
+		PublishReferenceOrbit(MoveTemp(CompletedOrbit), CompletedKey, CompletedVersion, false);
+	}
+
+	UpdateReferenceGrid();
+	UpdateSecondaryReferences();
+	UpdateQualityGovernor();
+	UpdatePipelineStats();
+}
+
+void UFractalControlSubsystem::UpdateQualityGovernor()
+{
+	FFractalRendererModule& Module = FModuleManager::GetModuleChecked<FFractalRendererModule>("FractalRenderer");
+	TSharedPtr<FFractalSceneViewExtension, ESPMode::ThreadSafe> Extension = Module.GetSceneViewExtension();
+	if (!Extension.IsValid())
+	{
+		return;
+	}
+
+	// Drain the sample either way, so re-enabling does not start from a stale one
+	float GpuTimeMs = 0.0f;
+	const bool bHasSample = Extension->ConsumeGpuTime(GpuTimeMs);
+
+	bool bBudgetsChanged = false;
+	if (CVarGovernorEnable.GetValueOnGameThread() == 0 || !FractalParameters.bEnabled)
+	{
+		bBudgetsChanged = QualityGovernor.Reset();
+	}
+	else if (bHasSample)
+	{
+		FFractalQualityGovernorSettings Settings;
+		Settings.TargetGpuMs = CVarGovernorTargetMs.GetValueOnGameThread();
+		Settings.Hysteresis = CVarGovernorHysteresis.GetValueOnGameThread();
+		Settings.MinQuality = CVarGovernorMinQuality.GetValueOnGameThread();
+		Settings.MinResolution = CVarGovernorMinResolution.GetValueOnGameThread();
+		Settings.RecoveryStep = CVarGovernorRecoveryStep.GetValueOnGameThread();
+		Settings.CooldownSamples = CVarGovernorCooldown.GetValueOnGameThread();
+		bBudgetsChanged = QualityGovernor.Update(GpuTimeMs, Settings);
+	}
+
+	if (bBudgetsChanged)
+	{
+		const FFractalParameter Rendered = QualityGovernor.Apply(FractalParameters);
+		UE_LOG(LogFractalControl, Log, TEXT("Governed budgets: ScreenPercentage %.1f, MaxRaySteps %d, MaxIterations %d, MinIterations %d, ConvergenceFactor %.4f"),
+			Rendered.ScreenPercentage, Rendered.MaxRaySteps, Rendered.MaxIterations, Rendered.MinIterations, Rendered.ConvergenceFactor);
+		UpdateSceneViewExtension();
+	}
+}
+
+void UFractalControlSubsystem::UpdatePipelineStats()
+{
+	const double Now = FPlatformTime::Seconds();
+	if (RegenerationWindowStart <= 0.0)
+	{
+		RegenerationWindowStart = Now;
+	}
+	else if (Now - RegenerationWindowStart >= 1.0)
+	{
+		PipelineStats.OrbitRegenerationsPerSecond = static_cast<float>(NumRegenerationsInWindow / (Now - RegenerationWindowStart));
+		NumRegenerationsInWindow = 0;
+		RegenerationWindowStart = Now;
+		TRACE_COUNTER_SET(FractalOrbitRegenerationsPerSecond, PipelineStats.OrbitRegenerationsPerSecond);
+	}
+
+	if (CurrentOrbit.IsValid())
+	{
+		PipelineStats.OrbitLength = CurrentOrbit->GetLength();
+		PipelineStats.NumReferences = 1 + GridOrbits.Num() + SecondaryOrbits.Num();
+	}
+	else
+	{
+		PipelineStats.OrbitLength = 0;
+		PipelineStats.NumReferences = 0;
+	}
+	PipelineStats.GovernorQuality = QualityGovernor.GetQuality();
+
+	FFractalRendererModule& Module = FModuleManager::GetModuleChecked<FFractalRendererModule>("FractalRenderer");
+	TSharedPtr<FFractalSceneViewExtension, ESPMode::ThreadSafe> Extension = Module.GetSceneViewExtension();
+	if (Extension.IsValid())
+	{
+		FFractalRenderThreadStats RenderStats;
+		if (Extension->GetLatestRenderThreadStats(RenderStats))
+		{
+			PipelineStats.RenderThreadMs = RenderStats.RenderThreadMs;
+			PipelineStats.LockWaitMs = RenderStats.LockWaitMs;
+			PipelineStats.UploadBytes = RenderStats.UploadBytes;
+			PipelineStats.GpuMs = RenderStats.GpuMs;
+		}
+
+		FFractalMarchStats MarchStats;
+		if (Extension->GetLatestMarchStats(MarchStats))
+		{
+			PipelineStats.StepsPerPixel = MarchStats.GetStepsPerPixel();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_FractalOrbitLength, PipelineStats.OrbitLength);
+	SET_DWORD_STAT(STAT_FractalNumReferences, PipelineStats.NumReferences);
+	SET_FLOAT_STAT(STAT_FractalOrbitRegenerationsPerSecond, PipelineStats.OrbitRegenerationsPerSecond);
+}
+
+void UFractalControlSubsystem::UpdateReferenceGrid()
+{
+	FFractalRendererModule& Module = FModuleManager::GetModuleChecked<FFractalRendererModule>("FractalRenderer");
+	TSharedPtr<FFractalSceneViewExtension, ESPMode::ThreadSafe> Extension = Module.GetSceneViewExtension();
+	if (!Extension.IsValid() || !CurrentOrbit.IsValid())
+	{
+		return;
+	}
+
+	// Finished grid orbits only apply to the primary they were placed for
+	bool bHasCompletedGrid = false;
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> CompletedGridOrbits;
+	TArray<FVector3d> CompletedGridCenters;
+	{
+		FScopeLock Lock(&OrbitJobState->ResultMutex);
+		if (OrbitJobState->bHasCompletedGridOrbits && OrbitJobState->CompletedGridVersion == PublishedOrbitVersion)
+		{
+			CompletedGridOrbits = MoveTemp(OrbitJobState->CompletedGridOrbits);
+			CompletedGridCenters = MoveTemp(OrbitJobState->CompletedGridCenters);
+			bHasCompletedGrid = true;
+			bGridJobInFlight = false;
+		}
+		OrbitJobState->CompletedGridOrbits.Reset();
+		OrbitJobState->CompletedGridCenters.Reset();
+		OrbitJobState->bHasCompletedGridOrbits = false;
+	}
+
+	if (bHasCompletedGrid)
+	{
+		GridOrbits = MoveTemp(CompletedGridOrbits);
+		GridCenters = MoveTemp(CompletedGridCenters);
+		Extension->SetGridOrbits(GridOrbits, PublishedOrbitVersion);
+
+		// Grid rows come first in the shader's reference table; drop secondaries the same way the extension does
+		const int32 MaxSecondaryOrbits = FMath::Max(FRACTAL_MAX_REFERENCES - 1 - GridOrbits.Num(), 0);
+		if (SecondaryOrbits.Num() > MaxSecondaryOrbits)
+		{
+			SecondaryOrbits.SetNum(MaxSecondaryOrbits);
+		}
+
+		UE_LOG(LogFractalControl, Verbose, TEXT("Published %d grid reference orbits for v%llu"), GridOrbits.Num(), PublishedOrbitVersion);
+	}
+
+	// A running job finishes with its centers even if the camera has moved on; the next tick catches up
+	FFractalViewFrustum Frustum;
+	if (bGridJobInFlight || IsOrbitGenerationPending() || !Extension->GetLastViewFrustum(Frustum))
+	{
+		return;
+	}
+
+	const int32 Resolution = FMath::Max(CVarReferenceGridResolution.GetValueOnGameThread(), 0);
+	const int32 DepthSlices = FMath::Max(CVarReferenceGridDepthSlices.GetValueOnGameThread(), 1);
+	const TArray<FVector3d> Centers = ComputeGridReferenceCenters(Frustum, FractalParameters, Resolution, DepthSlices, FRACTAL_MAX_REFERENCES - 1);
+	if (IsReferenceGridCurrent(Centers, GridCenters))
+	{
+		return;
+	}
+
+	UE_LOG(LogFractalControl, Verbose, TEXT("Generating %d grid reference orbits for v%llu"), Centers.Num(), PublishedOrbitVersion);
+
+	bGridJobInFlight = true;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Generator = OrbitGenerator, JobState = OrbitJobState, Version = PublishedOrbitVersion, Centers,
+		 Power = CurrentOrbit->Power, MaxIterations = FractalParameters.MaxIterations, BailoutRadius = CurrentOrbit->BailoutRadius, Precision = CurrentOrbit->Precision]()
+		{
+			// A newer primary orbit makes the whole grid useless
+			const auto IsStale = [&JobState, Version]()
+			{
+				return JobState->LatestRequestedVersion.load(std::memory_order_relaxed) != Version;
+			};
+
+			// Grid orbits are independent, so they are generated side by side
+			TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> Orbits;
+			Orbits.SetNum(Centers.Num());
+			ParallelFor(Centers.Num(), [&](int32 Index)
+			{
+				FReferenceOrbit Orbit = Generator->GenerateOrbit(Centers[Index], Power, MaxIterations, BailoutRadius, IsStale, Precision);
+				if (!IsStale() && Orbit.IsValid())
+				{
+					Orbits[Index] = MakeShared<const FReferenceOrbit, ESPMode::ThreadSafe>(MoveTemp(Orbit));
+				}
+			});
+			if (IsStale())
+			{
+				return;
+			}
+			Orbits.RemoveAll([](const TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>& Orbit) { return !Orbit.IsValid(); });
+
+			FScopeLock Lock(&JobState->ResultMutex);
+			JobState->CompletedGridOrbits = MoveTemp(Orbits);
+			JobState->CompletedGridCenters = Centers;
+			JobState->CompletedGridVersion = Version;
+			JobState->bHasCompletedGridOrbits = true;
+		});
+}
+
+void UFractalControlSubsystem::UpdateSecondaryReferences()
+{
+	FFractalRendererModule& Module = FModuleManager::GetModuleChecked<FFractalRendererModule>("FractalRenderer");
+	TSharedPtr<FFractalSceneViewExtension, ESPMode::ThreadSafe> Extension = Module.GetSceneViewExtension();
+	if (!Extension.IsValid() || !CurrentOrbit.IsValid())
+	{
+		return;
+	}
+
+	// Finished secondary orbits only apply to the primary they were placed for
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> CompletedSecondaryOrbits;
+	{
+		FScopeLock Lock(&OrbitJobState->ResultMutex);
+		if (OrbitJobState->bHasCompletedSecondaryOrbits && OrbitJobState->CompletedSecondaryVersion == PublishedOrbitVersion)
+		{
+			CompletedSecondaryOrbits = MoveTemp(OrbitJobState->CompletedSecondaryOrbits);
+			bSecondaryJobInFlight = false;
+		}
+		OrbitJobState->CompletedSecondaryOrbits.Reset();
+		OrbitJobState->bHasCompletedSecondaryOrbits = false;
+	}
+
+	if (CompletedSecondaryOrbits.Num() > 0)
+	{
+		SecondaryOrbits.Append(MoveTemp(CompletedSecondaryOrbits));
+		Extension->SetSecondaryOrbits(SecondaryOrbits, PublishedOrbitVersion);
+
+		UE_LOG(LogFractalControl, Log, TEXT("Published %d secondary reference orbits for v%llu"), SecondaryOrbits.Num(), PublishedOrbitVersion);
+	}
+
+	FFractalGlitchReport Report;
+	if (!Extension->ConsumeGlitchReport(Report))
+	{
+		return;
+	}
+
+	// Only act on frames rendered with the current primary and every grid and secondary orbit published so far
+	const int32 MaxSecondaryReferences = FMath::Clamp(CVarGlitchMaxSecondaryReferences.GetValueOnGameThread(), 0, FRACTAL_MAX_REFERENCES - 1 - GridOrbits.Num());
+	if (bSecondaryJobInFlight
+		|| bGridJobInFlight
+		|| IsOrbitGenerationPending()
+		|| Report.OrbitVersion != PublishedOrbitVersion
+		|| Report.NumReferences != 1 + GridOrbits.Num() + SecondaryOrbits.Num()
+		|| SecondaryOrbits.Num() >= MaxSecondaryReferences
+		|| Report.NumGlitchedPixels < static_cast<uint32>(FMath::Max(CVarGlitchMinPixels.GetValueOnGameThread(), 1)))
+	{
+		return;
+	}
+
+	TArray<FVector3d> ExistingCenters;
+	ExistingCenters.Add(CurrentOrbit->ReferenceCenter);
+	for (const TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>& Orbit : GridOrbits)
+	{
+		ExistingCenters.Add(Orbit->ReferenceCenter);
+	}
+	for (const TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>& Orbit : SecondaryOrbits)
+	{
+		ExistingCenters.Add(Orbit->ReferenceCenter);
+	}
+
+	const TArray<FVector3d> Centers = SelectGlitchReferenceCenters(Report.Samples, MaxSecondaryReferences - SecondaryOrbits.Num(), ExistingCenters);
+	if (Centers.Num() == 0)
+	{
+		return;
+	}
+
+	UE_LOG(LogFractalControl, Verbose, TEXT("%u glitched pixels in v%llu, generating %d secondary reference orbits"),
+		Report.NumGlitchedPixels, PublishedOrbitVersion, Centers.Num());
+
+	bSecondaryJobInFlight = true;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Generator = OrbitGenerator, JobState = OrbitJobState, Version = PublishedOrbitVersion, Centers,
+		 Power = CurrentOrbit->Power, MaxIterations = FractalParameters.MaxIterations, BailoutRadius = CurrentOrbit->BailoutRadius, Precision = CurrentOrbit->Precision]()
+		{
+			// A newer primary orbit makes these secondaries useless
+			const auto IsStale = [&JobState, Version]()
+			{
+				return JobState->LatestRequestedVersion.load(std::memory_order_relaxed) != Version;
+			};
+
+			TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> Orbits;
+			for (const FVector3d& Center : Centers)
+			{
+				FReferenceOrbit Orbit = Generator->GenerateOrbit(Center, Power, MaxIterations, BailoutRadius, IsStale, Precision);
+				if (IsStale())
+				{
+					return;
+				}
+				if (Orbit.IsValid())
+				{
+					Orbits.Add(MakeShared<const FReferenceOrbit, ESPMode::ThreadSafe>(MoveTemp(Orbit)));
+				}
+			}
+
+			FScopeLock Lock(&JobState->ResultMutex);
+			JobState->CompletedSecondaryOrbits = MoveTemp(Orbits);
+			JobState->CompletedSecondaryVersion = Version;
+			JobState->bHasCompletedSecondaryOrbits = true;
+		});
+}
+
+TStatId UFractalControlSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFractalControlSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType UFractalControlSubsystem::GetTickableTickType() const
+{
+	// The class default object never owns orbit jobs
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+const FReferenceOrbit& UFractalControlSubsystem::GetReferenceOrbit() const
+{
+	static const FReferenceOrbit EmptyOrbit;
+	return CurrentOrbit.IsValid() ? *CurrentOrbit : EmptyOrbit;
+}
+
 void UFractalControlSubsystem::SetFractalParameters(const FFractalParameter& InParams)
 {
 	FractalParameters = InParams;
@@ -73,6 +733,23 @@ void UFractalControlSubsystem::SetZoom(float InZoom)
 	if (!FMath::IsNearlyEqual(FractalParameters.Zoom, InZoom))
 	{
 		FractalParameters.Zoom = InZoom;
+
+		// Zooming past the extended-precision threshold changes the Auto orbit precision
+		if (ShouldRegenerateOrbit(FractalParameters))
+		{
+			GenerateReferenceOrbit();
+		}
+
+		UpdateSceneViewExtension();
+	}
+}
+
+void UFractalControlSubsystem::SetScreenPercentage(float InScreenPercentage)
+{
+	const float Clamped = FMath::Clamp(InScreenPercentage, 10.0f, 100.0f);
+	if (!FMath::IsNearlyEqual(FractalParameters.ScreenPercentage, Clamped))
+	{
+		FractalParameters.ScreenPercentage = Clamped;
 		UpdateSceneViewExtension();
 	}
 }
@@ -101,7 +778,7 @@ void UFractalControlSubsystem::SetMaxIterations(int32 InMaxIterations)
 	{
 		FractalParameters.MaxIterations = InMaxIterations;
 		
-		// Iteration count change requires orbit regeneration
+		// Iteration count change extends or truncates the current orbit instead of recomputing it
 		GenerateReferenceOrbit();
 		
 		UpdateSceneViewExtension();
@@ -152,23 +829,48 @@ void UFractalControlSubsystem::SetFractalPower(float InFractalPower)
 	}
 }
 
+void UFractalControlSubsystem::SetOrbitPrecision(EFractalOrbitPrecision InOrbitPrecision)
+{
+	if (FractalParameters.OrbitPrecision != InOrbitPrecision)
+	{
+		FractalParameters.OrbitPrecision = InOrbitPrecision;
+
+		if (ShouldRegenerateOrbit(FractalParameters))
+		{
+			GenerateReferenceOrbit();
+		}
+
+		UpdateSceneViewExtension();
+	}
+}
+
 void UFractalControlSubsystem::RegenerateOrbit()
 {
 	GenerateReferenceOrbit();
 	UpdateSceneViewExtension();
 }
 
+FFractalOrbitCacheStats UFractalControlSubsystem::GetOrbitCacheStats() const
+{
+	return OrbitCache.GetStats();
+}
+
+SIZE_T UFractalControlSubsystem::GetOrbitCacheBudgetBytes()
+{
+	return static_cast<SIZE_T>(FMath::Max(CVarOrbitCacheBudgetMB.GetValueOnGameThread(), 0.0f) * 1024.0 * 1024.0);
+}
+
 bool UFractalControlSubsystem::ShouldRegenerateOrbit(const FFractalParameter& NewParams) const
 {
-	// Regenerate if critical parameters changed
-	const double CenterThreshold = 0.01; // Relative to zoom
-	
+	// Regenerate if critical parameters changed. GenerateReferenceOrbit consults the orbit cache
+	// before recomputing, so returning true for a previously visited state is cheap.
+
 	// Check center movement (relative to current zoom level)
 	FVector2D CenterDelta = NewParams.Center - LastOrbitParams.Center;
 	double CenterDistance = CenterDelta.Length();
 	double RelativeCenterChange = CenterDistance / FMath::Max(NewParams.Zoom, 1e-10);
 	
-	if (RelativeCenterChange > CenterThreshold)
+	if (RelativeCenterChange > OrbitCenterThreshold)
 	{
 		return true;
 	}
@@ -190,45 +892,159 @@ bool UFractalControlSubsystem::ShouldRegenerateOrbit(const FFractalParameter& Ne
 	{
 		return true;
 	}
+
+	// Check if the orbit precision changed (explicitly or through Auto crossing the zoom threshold)
+	if (ResolveOrbitPrecision(NewParams) != ResolveOrbitPrecision(LastOrbitParams))
+	{
+		return true;
+	}
 	
 	return false;
 }
 
 void UFractalControlSubsystem::GenerateReferenceOrbit()
 {
-	if (!OrbitGenerator.IsValid())
+	if (!OrbitGenerator.IsValid() || !OrbitJobState.IsValid())
 	{
 		UE_LOG(LogFractalControl, Warning, TEXT("Orbit generator not initialized"));
 		return;
 	}
 	
-	TRACE_CPUPROFILER_EVENT_SCOPE(UFractalControlSubsystem::GenerateReferenceOrbit);
+	FRACTAL_TRACE_SCOPE(UFractalControlSubsystem::GenerateReferenceOrbit);
 	
 	// Reference center in fractal space (Center is 2D, we use Z=0 for 3D Mandelbulb)
-	FVector3d ReferenceCenter(FractalParameters.Center.X, FractalParameters.Center.Y, 0.0);
-	
-	// Generate orbit in double precision
-	CurrentOrbit = OrbitGenerator->GenerateOrbit(
-		ReferenceCenter,
-		static_cast<double>(FractalParameters.FractalPower),
-		FractalParameters.MaxIterations,
-		static_cast<double>(FractalParameters.BailoutRadius)
-	);
-	
-	// Store parameters used for this orbit
+	const FVector3d ReferenceCenter(FractalParameters.Center.X, FractalParameters.Center.Y, 0.0);
+	const double Power = static_cast<double>(FractalParameters.FractalPower);
+	const int32 MaxIterations = FractalParameters.MaxIterations;
+	const double BailoutRadius = static_cast<double>(FractalParameters.BailoutRadius);
+	const EFractalOrbitPrecision Precision = ResolveOrbitPrecision(FractalParameters);
+	const FOrbitCacheKey CacheKey = FOrbitCacheKey::Make(FractalParameters, OrbitCenterThreshold * FractalParameters.Zoom, Precision);
+
+	// Candidates stay within the drift that would trigger a new orbit anyway, i.e. within the cache cell
+	const double SearchRadius = OrbitCenterThreshold * FractalParameters.Zoom;
+	const int32 SearchCandidatesPerAxis = CVarReferenceSearchCandidatesPerAxis.GetValueOnGameThread();
+
+	// Store parameters used for this orbit so repeated setters do not queue duplicate jobs
 	LastOrbitParams = FractalParameters;
-	
+
+	// Publishing a newer version makes any in-flight job stale; it polls this and bails out
+	const uint64 Version = ++RequestedOrbitVersion;
+	OrbitJobState->LatestRequestedVersion.store(Version);
+
+	// Revisiting a cached state (panning back, toggling power) publishes immediately without a job
+	OrbitCache.SetBudgetBytes(GetOrbitCacheBudgetBytes());
+	if (TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe> CachedOrbit = OrbitCache.Find(CacheKey))
+	{
+		PublishReferenceOrbit(MoveTemp(CachedOrbit), CacheKey, Version, true);
+		return;
+	}
+
+	// When only the iteration count changed, the current orbit is extended (or truncated) rather than
+	// recomputed from z_0. Published orbits are immutable and shared with the cache and the renderer, so
+	// the job edits a copy and publishes it under the new key; until then the current orbit stays as it is.
+	TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe> SourceOrbit;
+	if (CurrentOrbit.IsValid() && CurrentOrbitKey.MatchesExceptIterations(CacheKey))
+	{
+		SourceOrbit = CurrentOrbit;
+	}
+
+	++NumRegenerationsInWindow;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Generator = OrbitGenerator, JobState = OrbitJobState, SourceOrbit, Version, CacheKey, ReferenceCenter, SearchRadius, SearchCandidatesPerAxis, Power, MaxIterations, BailoutRadius, Precision]()
+		{
+			FRACTAL_TRACE_SCOPE(FractalOrbitJob);
+			const double StartSeconds = FPlatformTime::Seconds();
+			const auto IsStale = [&JobState, Version]()
+			{
+				return JobState->LatestRequestedVersion.load(std::memory_order_relaxed) != Version;
+			};
+
+			TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe> Result;
+			if (SourceOrbit.IsValid())
+			{
+				if (IsStale())
+				{
+					return;
+				}
+
+				// One copy of the computed points, laid out for the new length, then only the delta is iterated (or dropped)
+				FReferenceOrbit Orbit(*SourceOrbit, MaxIterations + 1);
+				if (!Generator->ExtendOrbit(Orbit, MaxIterations, IsStale))
+				{
+					return;
+				}
+				Result = MakeShared<const FReferenceOrbit, ESPMode::ThreadSafe>(MoveTemp(Orbit));
+			}
+			else
+			{
+				// A reference escaping early would cap every pixel's perturbation, so look for a longer-lived one nearby
+				FVector3d OrbitCenter = ReferenceCenter;
+				if (SearchCandidatesPerAxis > 1)
+				{
+					const FReferenceCenterSearchResult Search = Generator->SelectReferenceCenter(ReferenceCenter, SearchRadius, Power, MaxIterations, BailoutRadius, SearchCandidatesPerAxis, IsStale);
+					if (IsStale())
+					{
+						return;
+					}
+					if (Search.bCompleted)
+					{
+						OrbitCenter = Search.Center;
+						UE_LOG(LogFractalControl, Log, TEXT("Reference search v%llu: %d candidates in %.2f ms, orbit length %d (view center %d)%s"),
+							Version, Search.NumCandidates, Search.Seconds * 1000.0, Search.GetOrbitLength(MaxIterations),
+							Search.GetBaselineOrbitLength(MaxIterations),
+							Search.Period > 0 ? *FString::Printf(TEXT(", period %d"), Search.Period) : TEXT(""));
+					}
+				}
+
+				FReferenceOrbit Orbit = Generator->GenerateOrbit(OrbitCenter, Power, MaxIterations, BailoutRadius, IsStale, Precision);
+				Result = MakeShared<const FReferenceOrbit, ESPMode::ThreadSafe>(MoveTemp(Orbit));
+			}
+
+			if (IsStale() || !Result->IsValid())
+			{
+				return;
+			}
+
+			FScopeLock Lock(&JobState->ResultMutex);
+			if (Version > JobState->CompletedVersion)
+			{
+				JobState->CompletedOrbit = MoveTemp(Result);
+				JobState->CompletedKey = CacheKey;
+				JobState->CompletedVersion = Version;
+				JobState->CompletedSeconds = FPlatformTime::Seconds() - StartSeconds;
+			}
+		});
+}
+
+void UFractalControlSubsystem::PublishReferenceOrbit(TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe> InOrbit, const FOrbitCacheKey& InKey, uint64 InVersion, bool bFromCache)
+{
+	CurrentOrbit = MoveTemp(InOrbit);
+	CurrentOrbitKey = InKey;
+	PublishedOrbitVersion = InVersion;
+
+	// Grid and secondary orbits were generated for the previous orbit; any job still running for them is now stale
+	GridOrbits.Reset();
+	GridCenters.Reset();
+	bGridJobInFlight = false;
+	SecondaryOrbits.Reset();
+	bSecondaryJobInFlight = false;
+
 	UE_LOG(LogFractalControl, Log, 
-		TEXT("Generated reference orbit: Center=(%.6f, %.6f, 0.0), Power=%.2f, Iterations=%d, Valid=%s"),
-		ReferenceCenter.X, ReferenceCenter.Y,
-		FractalParameters.FractalPower,
-		CurrentOrbit.GetLength(),
-		CurrentOrbit.IsValid() ? TEXT("Yes") : TEXT("No")
+		TEXT("%s reference orbit v%llu: Center=(%.6f, %.6f, %.6f), Power=%.2f, Precision=%s, Iterations=%d, Memory=%.2f MB (%.1f B/point), Valid=%s"),
+		bFromCache ? TEXT("Cached") : TEXT("Generated"),
+		InVersion,
+		CurrentOrbit->ReferenceCenter.X, CurrentOrbit->ReferenceCenter.Y, CurrentOrbit->ReferenceCenter.Z,
+		CurrentOrbit->Power,
+		*UEnum::GetValueAsString(CurrentOrbit->Precision),
+		CurrentOrbit->GetLength(),
+		CurrentOrbit->GetAllocatedSize() / (1024.0 * 1024.0),
+		static_cast<double>(CurrentOrbit->GetAllocatedSize()) / FMath::Max(CurrentOrbit->GetLength(), 1),
+		CurrentOrbit->IsValid() ? TEXT("Yes") : TEXT("No")
 	);
 
 	if (GEngine)
 	{
-		FString OrbitMessage = FString::Printf(TEXT("Fractal orbit regenerated (%d points)"), CurrentOrbit.GetLength());
+		FString OrbitMessage = FString::Printf(TEXT("Fractal orbit %s (%d points)"), bFromCache ? TEXT("restored from cache") : TEXT("regenerated"), CurrentOrbit->GetLength());
 		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Cyan, OrbitMessage);
 	}
 	
@@ -238,8 +1054,27 @@ void UFractalControlSubsystem::GenerateReferenceOrbit()
 	
 	if (Extension.IsValid())
 	{
-		Extension->SetReferenceOrbit(CurrentOrbit);
+		// Packs the upload rows and snapshot on this thread, the last step before the render thread picks it up
+		const double PublishStart = FPlatformTime::Seconds();
+		Extension->SetReferenceOrbit(*CurrentOrbit, InVersion);
+		PipelineStats.OrbitPackingMs = static_cast<float>((FPlatformTime::Seconds() - PublishStart) * 1000.0);
+		SET_FLOAT_STAT(STAT_FractalOrbitPublishMs, PipelineStats.OrbitPackingMs);
+	}
+
+	PipelineStats.OrbitLength = CurrentOrbit->GetLength();
+	TRACE_COUNTER_SET(FractalOrbitLength, PipelineStats.OrbitLength);
+}
+
+TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> UFractalControlSubsystem::GetReferenceOrbits() const
+{
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> Orbits;
+	if (CurrentOrbit.IsValid())
+	{
+		Orbits.Add(CurrentOrbit);
+		Orbits.Append(GridOrbits);
+		Orbits.Append(SecondaryOrbits);
 	}
+	return Orbits;
 }
 
 void UFractalControlSubsystem::UpdateSceneViewExtension()
@@ -248,8 +1083,9 @@ void UFractalControlSubsystem::UpdateSceneViewExtension()
 	FFractalRendererModule& Module = FModuleManager::GetModuleChecked<FFractalRendererModule>("FractalRenderer");
 	TSharedPtr<FFractalSceneViewExtension, ESPMode::ThreadSafe> Extension = Module.GetSceneViewExtension();
 	
+	// The governor only lowers budgets the orbit already covers, so this never affects orbit generation
 	if (Extension.IsValid())
 	{
-		Extension->SetFractalParameters(FractalParameters);
+		Extension->SetFractalParameters(QualityGovernor.Apply(FractalParameters), FractalParameters.MaxIterations);
 	}
 }
@@ -0,0 +1,1111 @@
+#include "FractalCpuRenderer.h"
+#include "MandelbulbMath.h"
+#include "FractalControlSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "ImageUtils.h"
+#include "ImageCore.h"
+#include "Misc/Paths.h"
+#include "FractalStats.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFractalCpuRenderer, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("CPU Reference Render"), STAT_FractalCpuRender, STATGROUP_Fractal);
+
+namespace
+{
+	// PAULDELBROT_TOLERANCE in PerturbationShader.usf
+	constexpr double PauldelbrotTolerance = 1e-3;
+
+	// Near plane of FromViewpoint's projection; ray directions do not depend on it
+	constexpr double CameraNearPlane = 10.0;
+
+	// HIT_STATUS_* in PerturbationShader.usf
+	enum class ECpuHitStatus : uint8
+	{
+		None,
+		Hit,
+		MissDistance,
+		MissSteps
+	};
+
+	struct FCpuDEResult
+	{
+		double Distance = 0.0;
+		int32 Iterations = 0;
+		bool bGlitched = false;
+	};
+
+	struct FCpuMarchResult
+	{
+		double Distance = 0.0;
+		int32 Steps = 0;
+		int32 TotalDEIterations = 0;
+		ECpuHitStatus HitStatus = ECpuHitStatus::None;
+		bool bGlitched = false;
+	};
+
+	// Counters of one tile. Adjacent tiles' entries share cache lines, so a worker counts into a local copy
+	// and stores it once when the tile is done; the entries are summed once every tile is done.
+	struct FCpuTileStats
+	{
+		int64 NumSteps = 0;
+		int64 NumDEIterations = 0;
+		int32 NumHits = 0;
+		int32 NumDistanceMisses = 0;
+		int32 NumStepLimited = 0;
+		int32 NumGlitchedPixels = 0;
+		double Seconds = 0.0;
+		uint32 ThreadId = 0;
+	};
+
+	FCpuDEResult MakeDEResult(double Radius, double Derivative, int32 Iterations)
+	{
+		const double SafeRadius = FMath::Max(Radius, 1e-6);
+		const double SafeDerivative = FMath::Max(FMath::Abs(Derivative), 1e-10);
+
+		FCpuDEResult Result;
+		Result.Distance = 0.5 * FMath::Loge(SafeRadius) * SafeRadius / SafeDerivative;
+		Result.Iterations = Iterations;
+		return Result;
+	}
+
+	FCpuDEResult MakeFallbackDEResult(double PrecisionThreshold, bool bGlitched)
+	{
+		FCpuDEResult Fallback;
+		Fallback.Distance = PrecisionThreshold;
+		Fallback.bGlitched = bGlitched;
+		return Fallback;
+	}
+
+	/**
+	 * The shader's march and perturbation DE in double, instantiated per power so the map is the
+	 * trig-free polynomial for integer powers (P > 0) and the spherical form otherwise (P == 0).
+	 * Where the shader approximates to save work in float (reusing the reference's stored derivative
+	 * scale), the exact double value is used instead.
+	 */
+	template <int32 P>
+	class TCpuMarcher
+	{
+	public:
+		TCpuMarcher(const FFractalParameter& InParameters, TConstArrayView<const FReferenceOrbit*> InReferences, const FFractalCpuCamera& InCamera, bool bInUseSeriesApproximation)
+			: Parameters(InParameters)
+			, References(InReferences)
+			, Camera(InCamera)
+			, Power(InParameters.FractalPower)
+			, BailoutRadius(InParameters.BailoutRadius)
+			, bUseSeriesApproximation(bInUseSeriesApproximation)
+		{
+		}
+
+		/** March every pixel of [Min, Max) one ray at a time, handing each result to OnPixel(X, Y, Result). */
+		template <typename FunctorType>
+		void MarchTile(const FIntPoint& Min, const FIntPoint& Max, FunctorType&& OnPixel) const
+		{
+			for (int32 Y = Min.Y; Y < Max.Y; ++Y)
+			{
+				for (int32 X = Min.X; X < Max.X; ++X)
+				{
+					FVector3d RayOrigin, RayDirection;
+					GetPixelRay(X, Y, RayOrigin, RayDirection);
+					OnPixel(X, Y, March(RayOrigin, RayDirection));
+				}
+			}
+		}
+
+		FCpuMarchResult March(const FVector3d& RayOrigin, const FVector3d& RayDirection) const
+		{
+			const double ScaleMultiplier = Parameters.Zoom;
+			const double MaxWorldDistance = Parameters.MaxRayDistance;
+			const FVector3d CenterOffset(Parameters.Center.X, Parameters.Center.Y, 0.0);
+
+			FCpuMarchResult Result;
+			double TotalDistance = 0.0;
+			while (TotalDistance < MaxWorldDistance && Result.Steps < Parameters.MaxRaySteps)
+			{
+				++Result.Steps;
+				const FVector3d Position = CenterOffset + (RayOrigin + RayDirection * TotalDistance) * ScaleMultiplier;
+
+				const double PixelSizeFractal = Camera.GetPixelWorldRadius(TotalDistance) * ScaleMultiplier;
+				const FCpuDEResult DE = EstimateDistance(Position, PixelSizeFractal);
+				Result.TotalDEIterations += DE.Iterations;
+				Result.bGlitched |= DE.bGlitched;
+
+				if (DE.Distance <= PixelSizeFractal)
+				{
+					Result.Distance = TotalDistance;
+					Result.HitStatus = ECpuHitStatus::Hit;
+					return Result;
+				}
+
+				const double FractalStep = FMath::Max(DE.Distance, PixelSizeFractal * 0.5);
+				TotalDistance += FractalStep / FMath::Max(ScaleMultiplier, 1e-6);
+			}
+
+			Result.Distance = TotalDistance;
+			Result.HitStatus = TotalDistance >= MaxWorldDistance ? ECpuHitStatus::MissDistance : ECpuHitStatus::MissSteps;
+			return Result;
+		}
+
+	protected:
+		const FFractalParameter& Parameters;
+		TConstArrayView<const FReferenceOrbit*> References;
+		const FFractalCpuCamera& Camera;
+		double Power;
+		double BailoutRadius;
+		bool bUseSeriesApproximation;
+
+		void GetPixelRay(int32 X, int32 Y, FVector3d& OutOrigin, FVector3d& OutDirection) const
+		{
+			Camera.GetRay(FVector2D(X + 0.5, Y + 0.5) + Camera.SampleJitter, OutOrigin, OutDirection);
+		}
+
+		// Closest and second-closest references with orbit data (INDEX_NONE when there are not that many)
+		void FindNearestReferences(const FVector3d& Position, int32& Nearest, int32& SecondNearest) const
+		{
+			Nearest = INDEX_NONE;
+			SecondNearest = INDEX_NONE;
+			double NearestDistance = UE_DOUBLE_BIG_NUMBER;
+			double SecondDistance = UE_DOUBLE_BIG_NUMBER;
+			for (int32 Index = 0; Index < References.Num(); ++Index)
+			{
+				if (References[Index]->GetLength() <= 1)
+				{
+					continue;
+				}
+
+				const double Distance = FVector3d::Distance(Position, References[Index]->ReferenceCenter);
+				if (Distance < NearestDistance)
+				{
+					SecondNearest = Nearest;
+					SecondDistance = NearestDistance;
+					Nearest = Index;
+					NearestDistance = Distance;
+				}
+				else if (Distance < SecondDistance)
+				{
+					SecondNearest = Index;
+					SecondDistance = Distance;
+				}
+			}
+		}
+
+		FCpuDEResult EstimateDistance(const FVector3d& Position, double PrecisionThreshold) const
+		{
+			// Primary, grid and glitch references compete on distance; the closest keeps eps smallest
+			int32 Nearest, SecondNearest;
+			FindNearestReferences(Position, Nearest, SecondNearest);
+			if (Nearest == INDEX_NONE)
+			{
+				return MakeFallbackDEResult(PrecisionThreshold, false);
+			}
+
+			FCpuDEResult Result = PerturbFromReference(*References[Nearest], Position, PrecisionThreshold, SecondNearest != INDEX_NONE);
+			if (Result.bGlitched && SecondNearest != INDEX_NONE)
+			{
+				FCpuDEResult Retry = PerturbFromReference(*References[SecondNearest], Position, PrecisionThreshold, false);
+				Retry.Iterations += Result.Iterations;
+				Result = Retry;
+			}
+			return Result;
+		}
+
+		double DerivativeScale(double Radius) const
+		{
+			const double SafeRadius = FMath::Max(Radius, 1e-6);
+			if constexpr (P > 1)
+			{
+				return P * MandelbulbMath::IntPow<P - 1>(SafeRadius);
+			}
+			else
+			{
+				return Power * FMath::Pow(SafeRadius, Power - 1.0);
+			}
+		}
+
+		FCpuDEResult PerturbFromReference(const FReferenceOrbit& Orbit, const FVector3d& Position, double PrecisionThreshold, bool bStopOnGlitch) const
+		{
+			const int32 OrbitLength = Orbit.GetLength();
+			const int32 MaxPerturbIterations = FMath::Min(Parameters.MaxIterations, OrbitLength - 1);
+			if (MaxPerturbIterations <= 0)
+			{
+				return MakeFallbackDEResult(PrecisionThreshold, false);
+			}
+
+			const double EpsilonBreakdown = FMath::Max(BailoutRadius * 16.0, 4.0);
+			const FVector3d Delta = Position - Orbit.ReferenceCenter;
+			if (Delta.Length() > EpsilonBreakdown)
+			{
+				return MakeFallbackDEResult(PrecisionThreshold, true);
+			}
+
+			// Iterations the series approximation covers are skipped; eps and dr start from their values there
+			FVector3d Epsilon = FVector3d::ZeroVector;
+			double Derivative = 1.0;
+			int32 StartIteration = 0;
+			if (bUseSeriesApproximation && Orbit.SeriesApproximation.IsValid())
+			{
+				const int32 Bucket = FOrbitSeriesApproximation::GetBucket(Delta.Length());
+				const int32 SkipIteration = Orbit.SeriesApproximation.GetSkipIteration(Bucket);
+				if (SkipIteration > 0 && SkipIteration <= MaxPerturbIterations)
+				{
+					StartIteration = SkipIteration;
+					Epsilon = Orbit.SeriesApproximation.Evaluate(Bucket, Delta);
+					Derivative = Orbit.SeriesApproximation.GetStartDerivative(Bucket);
+				}
+			}
+
+			FVector3d ZRef = Orbit.GetPosition(StartIteration);
+			FVector3d ZActual = ZRef + Epsilon;
+			double PrevDE = 1e10;
+			bool bGlitched = false;
+			int32 Iteration = StartIteration;
+			for (; Iteration < MaxPerturbIterations; ++Iteration)
+			{
+				const double Radius = ZActual.Length();
+				if (Radius > BailoutRadius)
+				{
+					break;
+				}
+
+				const double CurrentDE = 0.5 * FMath::Loge(FMath::Max(Radius, 1e-6)) * Radius / FMath::Max(Derivative, 1e-10);
+				if (Iteration >= Parameters.MinIterations && FMath::Abs(CurrentDE - PrevDE) < PrecisionThreshold * Parameters.ConvergenceFactor)
+				{
+					break;
+				}
+				PrevDE = CurrentDE;
+
+				Derivative = DerivativeScale(Radius) * Derivative + 1.0;
+
+				if (Iteration + 1 >= OrbitLength)
+				{
+					break;
+				}
+
+				const FVector3d ZRefNext = Orbit.GetPosition(Iteration + 1);
+				const FVector3d PerturbedNext = MandelbulbMath::PowerMap<P>(ZRef + Epsilon, Power) + Position;
+				Epsilon = PerturbedNext - ZRefNext;
+
+				const double EpsilonMagnitude = Epsilon.Length();
+				if (EpsilonMagnitude > EpsilonBreakdown)
+				{
+					Epsilon *= EpsilonBreakdown / EpsilonMagnitude;
+					bGlitched = true;
+				}
+
+				if (PerturbedNext.Length() < PauldelbrotTolerance * ZRefNext.Length())
+				{
+					bGlitched = true;
+				}
+
+				ZRef = ZRefNext;
+				ZActual = PerturbedNext;
+
+				if (bGlitched && bStopOnGlitch)
+				{
+					++Iteration;
+					break;
+				}
+			}
+
+			// The reference escaped before MaxIterations but this sample is still bounded: the orbit ran out under it
+			if (Iteration >= MaxPerturbIterations && MaxPerturbIterations < Parameters.MaxIterations && ZActual.Length() <= BailoutRadius)
+			{
+				bGlitched = true;
+			}
+
+			FCpuDEResult Result = MakeDEResult(ZActual.Length(), Derivative, Iteration);
+			Result.bGlitched = bGlitched;
+			return Result;
+		}
+	};
+
+	/**
+	 * TCpuMarcher for FDouble4::NumLanes rays at once. Each lane carries its own ray; a lane whose ray
+	 * finishes takes the tile's next one, so packets only run partly empty while the tile drains.
+	 * DE samples are grouped by nearest reference and each group iterates in lockstep, one SIMD lane per
+	 * sample, with finished lanes masked. Glitch retries are grouped the same way by their fallback.
+	 *
+	 * The loop matches the scalar one except for the series approximation: a group starts from the
+	 * bucket of its largest |delta|, which covers every lane of the group but may skip a little less.
+	 */
+	template <int32 P>
+	class TCpuPacketMarcher : public TCpuMarcher<P>
+	{
+		static_assert(P > 0, "Ray packets need the polynomial power map");
+
+		using FDouble4 = MandelbulbMath::FDouble4;
+		static constexpr int32 NumLanes = FDouble4::NumLanes;
+		static constexpr int32 AllLanes = (1 << NumLanes) - 1;
+
+	public:
+		using TCpuMarcher<P>::TCpuMarcher;
+
+		/** March every pixel of [Min, Max), handing each result to OnPixel(X, Y, Result) as its ray finishes. */
+		template <typename FunctorType>
+		void MarchTile(const FIntPoint& Min, const FIntPoint& Max, FunctorType&& OnPixel) const
+		{
+			const double ScaleMultiplier = this->Parameters.Zoom;
+			const double MaxWorldDistance = this->Parameters.MaxRayDistance;
+			const int32 MaxRaySteps = this->Parameters.MaxRaySteps;
+			const FVector3d CenterOffset(this->Parameters.Center.X, this->Parameters.Center.Y, 0.0);
+
+			struct FLaneRay
+			{
+				FIntPoint Pixel;
+				FVector3d Origin;
+				FVector3d Direction;
+				double TotalDistance = 0.0;
+				FCpuMarchResult Result;
+			};
+
+			const int32 TileWidth = Max.X - Min.X;
+			const int32 NumPixels = TileWidth * (Max.Y - Min.Y);
+			int32 NextPixel = 0;
+
+			// Loads the tile's next ray into a lane; false once the tile has none left
+			FLaneRay Lanes[NumLanes];
+			const auto StartRay = [&](int32 Lane)
+			{
+				while (NextPixel < NumPixels)
+				{
+					FLaneRay& Ray = Lanes[Lane];
+					Ray = FLaneRay();
+					Ray.Pixel = FIntPoint(Min.X + NextPixel % TileWidth, Min.Y + NextPixel / TileWidth);
+					++NextPixel;
+
+					if (MaxWorldDistance > 0.0 && MaxRaySteps > 0)
+					{
+						this->GetPixelRay(Ray.Pixel.X, Ray.Pixel.Y, Ray.Origin, Ray.Direction);
+						return true;
+					}
+
+					// Budgets that allow no step finish before the first sample, as in the scalar march
+					Ray.Result.HitStatus = MaxWorldDistance <= 0.0 ? ECpuHitStatus::MissDistance : ECpuHitStatus::MissSteps;
+					OnPixel(Ray.Pixel.X, Ray.Pixel.Y, Ray.Result);
+				}
+				return false;
+			};
+
+			int32 LaneBits = 0;
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				LaneBits |= StartRay(Lane) ? (1 << Lane) : 0;
+			}
+
+			while (LaneBits != 0)
+			{
+				FVector3d Positions[NumLanes];
+				double Thresholds[NumLanes] = {};
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+				{
+					if (LaneBits & (1 << Lane))
+					{
+						FLaneRay& Ray = Lanes[Lane];
+						++Ray.Result.Steps;
+						Positions[Lane] = CenterOffset + (Ray.Origin + Ray.Direction * Ray.TotalDistance) * ScaleMultiplier;
+						Thresholds[Lane] = this->Camera.GetPixelWorldRadius(Ray.TotalDistance) * ScaleMultiplier;
+					}
+				}
+
+				FCpuDEResult DE[NumLanes];
+				EstimateDistancePacket(Positions, Thresholds, LaneBits, DE);
+
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+				{
+					if (!(LaneBits & (1 << Lane)))
+					{
+						continue;
+					}
+
+					FLaneRay& Ray = Lanes[Lane];
+					Ray.Result.TotalDEIterations += DE[Lane].Iterations;
+					Ray.Result.bGlitched |= DE[Lane].bGlitched;
+
+					if (DE[Lane].Distance <= Thresholds[Lane])
+					{
+						Ray.Result.HitStatus = ECpuHitStatus::Hit;
+					}
+					else
+					{
+						Ray.TotalDistance += FMath::Max(DE[Lane].Distance, Thresholds[Lane] * 0.5) / FMath::Max(ScaleMultiplier, 1e-6);
+						if (Ray.TotalDistance >= MaxWorldDistance)
+						{
+							Ray.Result.HitStatus = ECpuHitStatus::MissDistance;
+						}
+						else if (Ray.Result.Steps >= MaxRaySteps)
+						{
+							Ray.Result.HitStatus = ECpuHitStatus::MissSteps;
+						}
+					}
+
+					if (Ray.Result.HitStatus != ECpuHitStatus::None)
+					{
+						Ray.Result.Distance = Ray.TotalDistance;
+						OnPixel(Ray.Pixel.X, Ray.Pixel.Y, Ray.Result);
+						LaneBits &= StartRay(Lane) ? AllLanes : ~(1 << Lane);
+					}
+				}
+			}
+		}
+
+	private:
+		void EstimateDistancePacket(const FVector3d (&Positions)[NumLanes], const double (&Thresholds)[NumLanes], int32 LaneBits, FCpuDEResult (&OutResults)[NumLanes]) const
+		{
+			int32 Nearest[NumLanes];
+			int32 SecondNearest[NumLanes];
+			int32 PendingBits = 0;
+			int32 StopOnGlitchBits = 0;
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				if (!(LaneBits & (1 << Lane)))
+				{
+					continue;
+				}
+
+				this->FindNearestReferences(Positions[Lane], Nearest[Lane], SecondNearest[Lane]);
+				if (Nearest[Lane] == INDEX_NONE)
+				{
+					OutResults[Lane] = MakeFallbackDEResult(Thresholds[Lane], false);
+					continue;
+				}
+				PendingBits |= 1 << Lane;
+				StopOnGlitchBits |= SecondNearest[Lane] != INDEX_NONE ? (1 << Lane) : 0;
+			}
+
+			PerturbGroups(Nearest, Positions, Thresholds, PendingBits, StopOnGlitchBits, OutResults);
+
+			// Retry glitched lanes from their next closest reference, keeping the iterations already spent
+			int32 RetryBits = 0;
+			int32 SpentIterations[NumLanes] = {};
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				if ((StopOnGlitchBits & (1 << Lane)) && OutResults[Lane].bGlitched)
+				{
+					RetryBits |= 1 << Lane;
+					SpentIterations[Lane] = OutResults[Lane].Iterations;
+				}
+			}
+
+			if (RetryBits != 0)
+			{
+				PerturbGroups(SecondNearest, Positions, Thresholds, RetryBits, 0, OutResults);
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+				{
+					OutResults[Lane].Iterations += SpentIterations[Lane];
+				}
+			}
+		}
+
+		// Runs the lanes of LaneBits in one packet per distinct reference in LaneReferences
+		void PerturbGroups(const int32 (&LaneReferences)[NumLanes], const FVector3d (&Positions)[NumLanes], const double (&Thresholds)[NumLanes], int32 LaneBits, int32 StopOnGlitchBits, FCpuDEResult (&OutResults)[NumLanes]) const
+		{
+			while (LaneBits != 0)
+			{
+				const int32 Reference = LaneReferences[FMath::CountTrailingZeros(static_cast<uint32>(LaneBits))];
+				int32 GroupBits = 0;
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+				{
+					GroupBits |= (LaneBits & (1 << Lane)) && LaneReferences[Lane] == Reference ? (1 << Lane) : 0;
+				}
+
+				PerturbPacket(*this->References[Reference], Positions, Thresholds, GroupBits, StopOnGlitchBits, OutResults);
+				LaneBits &= ~GroupBits;
+			}
+		}
+
+		// TCpuMarcher::PerturbFromReference for the lanes of LaneBits against one reference orbit
+		void PerturbPacket(const FReferenceOrbit& Orbit, const FVector3d (&Positions)[NumLanes], const double (&Thresholds)[NumLanes], int32 LaneBits, int32 StopOnGlitchBits, FCpuDEResult (&OutResults)[NumLanes]) const
+		{
+			const int32 OrbitLength = Orbit.GetLength();
+			const int32 MaxIterations = this->Parameters.MaxIterations;
+			const int32 MaxPerturbIterations = FMath::Min(MaxIterations, OrbitLength - 1);
+			const double EpsilonBreakdown = FMath::Max(this->BailoutRadius * 16.0, 4.0);
+
+			// Lanes outside LaneBits keep a harmless position so masked arithmetic stays finite
+			int32 ActiveBits = 0;
+			double MaxDeltaLength = 0.0;
+			FVector3d Deltas[NumLanes];
+			double PositionX[NumLanes] = {}, PositionY[NumLanes] = {}, PositionZ[NumLanes] = {};
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				if (!(LaneBits & (1 << Lane)))
+				{
+					continue;
+				}
+
+				Deltas[Lane] = Positions[Lane] - Orbit.ReferenceCenter;
+				const double DeltaLength = Deltas[Lane].Length();
+				if (MaxPerturbIterations <= 0 || DeltaLength > EpsilonBreakdown)
+				{
+					OutResults[Lane] = MakeFallbackDEResult(Thresholds[Lane], MaxPerturbIterations > 0);
+					continue;
+				}
+
+				ActiveBits |= 1 << Lane;
+				MaxDeltaLength = FMath::Max(MaxDeltaLength, DeltaLength);
+				PositionX[Lane] = Positions[Lane].X;
+				PositionY[Lane] = Positions[Lane].Y;
+				PositionZ[Lane] = Positions[Lane].Z;
+			}
+
+			if (ActiveBits == 0)
+			{
+				return;
+			}
+			const int32 PerturbedBits = ActiveBits;
+
+			// The bucket of the largest |delta| covers every lane, so the whole packet starts at its skip
+			double EpsilonX[NumLanes] = {}, EpsilonY[NumLanes] = {}, EpsilonZ[NumLanes] = {};
+			double StartDerivative = 1.0;
+			int32 StartIteration = 0;
+			if (this->bUseSeriesApproximation && Orbit.SeriesApproximation.IsValid())
+			{
+				const int32 Bucket = FOrbitSeriesApproximation::GetBucket(MaxDeltaLength);
+				const int32 SkipIteration = Orbit.SeriesApproximation.GetSkipIteration(Bucket);
+				if (SkipIteration > 0 && SkipIteration <= MaxPerturbIterations)
+				{
+					StartIteration = SkipIteration;
+					StartDerivative = Orbit.SeriesApproximation.GetStartDerivative(Bucket);
+					for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+					{
+						if (ActiveBits & (1 << Lane))
+						{
+							const FVector3d Epsilon = Orbit.SeriesApproximation.Evaluate(Bucket, Deltas[Lane]);
+							EpsilonX[Lane] = Epsilon.X;
+							EpsilonY[Lane] = Epsilon.Y;
+							EpsilonZ[Lane] = Epsilon.Z;
+						}
+					}
+				}
+			}
+
+			const FDouble4 PX = FDouble4::Load(PositionX);
+			const FDouble4 PY = FDouble4::Load(PositionY);
+			const FDouble4 PZ = FDouble4::Load(PositionZ);
+			const FDouble4 Breakdown(EpsilonBreakdown);
+			FDouble4 EX = FDouble4::Load(EpsilonX);
+			FDouble4 EY = FDouble4::Load(EpsilonY);
+			FDouble4 EZ = FDouble4::Load(EpsilonZ);
+			FDouble4 Derivative(StartDerivative);
+
+			FVector3d ZRef = Orbit.GetPosition(StartIteration);
+			FDouble4 ZX = FDouble4(ZRef.X) + EX;
+			FDouble4 ZY = FDouble4(ZRef.Y) + EY;
+			FDouble4 ZZ = FDouble4(ZRef.Z) + EZ;
+
+			double PrevDE[NumLanes];
+			int32 Iterations[NumLanes] = {};
+			for (double& LanePrevDE : PrevDE)
+			{
+				LanePrevDE = 1e10;
+			}
+			int32 GlitchedBits = 0;
+			int32 Iteration = StartIteration;
+			for (; Iteration < MaxPerturbIterations; ++Iteration)
+			{
+				const FDouble4 Radius = MandelbulbMath::Sqrt(ZX * ZX + ZY * ZY + ZZ * ZZ);
+				double LaneRadius[NumLanes], LaneDerivative[NumLanes];
+				Radius.Store(LaneRadius);
+				Derivative.Store(LaneDerivative);
+
+				// Escape and convergence per lane; the DE needs a log, which the vector layer lacks for doubles
+				int32 DoneBits = 0;
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+				{
+					if (!(ActiveBits & (1 << Lane)))
+					{
+						continue;
+					}
+
+					Iterations[Lane] = Iteration;
+					if (LaneRadius[Lane] > this->BailoutRadius)
+					{
+						DoneBits |= 1 << Lane;
+						continue;
+					}
+
+					const double CurrentDE = 0.5 * FMath::Loge(FMath::Max(LaneRadius[Lane], 1e-6)) * LaneRadius[Lane] / FMath::Max(LaneDerivative[Lane], 1e-10);
+					if (Iteration >= this->Parameters.MinIterations && FMath::Abs(CurrentDE - PrevDE[Lane]) < Thresholds[Lane] * this->Parameters.ConvergenceFactor)
+					{
+						DoneBits |= 1 << Lane;
+						continue;
+					}
+					PrevDE[Lane] = CurrentDE;
+				}
+
+				ActiveBits &= ~DoneBits;
+				if (ActiveBits == 0)
+				{
+					break;
+				}
+
+				const FDouble4 ActiveMask = MandelbulbMath::MaskFromBits(ActiveBits);
+				const FDouble4 Scale = FDouble4(static_cast<double>(P)) * MandelbulbMath::IntPow<P - 1>(MandelbulbMath::Max(Radius, FDouble4(1e-6)));
+				Derivative = MandelbulbMath::Select(ActiveMask, Scale * Derivative + FDouble4(1.0), Derivative);
+
+				if (Iteration + 1 >= OrbitLength)
+				{
+					break;
+				}
+
+				const FVector3d ZRefNext = Orbit.GetPosition(Iteration + 1);
+				FDouble4 NX, NY, NZ;
+				MandelbulbMath::PolynomialPowerMap<P>(FDouble4(ZRef.X) + EX, FDouble4(ZRef.Y) + EY, FDouble4(ZRef.Z) + EZ, NX, NY, NZ);
+				NX = NX + PX;
+				NY = NY + PY;
+				NZ = NZ + PZ;
+
+				FDouble4 NewEX = NX - FDouble4(ZRefNext.X);
+				FDouble4 NewEY = NY - FDouble4(ZRefNext.Y);
+				FDouble4 NewEZ = NZ - FDouble4(ZRefNext.Z);
+
+				const FDouble4 EpsilonMagnitude = MandelbulbMath::Sqrt(NewEX * NewEX + NewEY * NewEY + NewEZ * NewEZ);
+				const FDouble4 Clamped = MandelbulbMath::CompareGT(EpsilonMagnitude, Breakdown);
+				const FDouble4 ClampScale = MandelbulbMath::Select(Clamped, Breakdown / MandelbulbMath::Max(EpsilonMagnitude, FDouble4(1e-300)), FDouble4(1.0));
+				NewEX = NewEX * ClampScale;
+				NewEY = NewEY * ClampScale;
+				NewEZ = NewEZ * ClampScale;
+
+				const FDouble4 PauldelbrotLimit(PauldelbrotTolerance * ZRefNext.Length());
+				const FDouble4 PerturbedRadius = MandelbulbMath::Sqrt(NX * NX + NY * NY + NZ * NZ);
+				GlitchedBits |= (MandelbulbMath::MaskBits(Clamped) | MandelbulbMath::MaskBits(MandelbulbMath::CompareLT(PerturbedRadius, PauldelbrotLimit))) & ActiveBits;
+
+				EX = MandelbulbMath::Select(ActiveMask, NewEX, EX);
+				EY = MandelbulbMath::Select(ActiveMask, NewEY, EY);
+				EZ = MandelbulbMath::Select(ActiveMask, NewEZ, EZ);
+				ZX = MandelbulbMath::Select(ActiveMask, NX, ZX);
+				ZY = MandelbulbMath::Select(ActiveMask, NY, ZY);
+				ZZ = MandelbulbMath::Select(ActiveMask, NZ, ZZ);
+				ZRef = ZRefNext;
+
+				// Lanes with a fallback stop at their first glitch, counting the iteration they glitched in
+				const int32 StoppedBits = GlitchedBits & StopOnGlitchBits & ActiveBits;
+				if (StoppedBits != 0)
+				{
+					for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+					{
+						Iterations[Lane] = (StoppedBits & (1 << Lane)) ? Iteration + 1 : Iterations[Lane];
+					}
+					ActiveBits &= ~StoppedBits;
+					if (ActiveBits == 0)
+					{
+						break;
+					}
+				}
+			}
+
+			// Lanes still running ended with the loop
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				Iterations[Lane] = (ActiveBits & (1 << Lane)) ? Iteration : Iterations[Lane];
+			}
+
+			double LaneX[NumLanes], LaneY[NumLanes], LaneZ[NumLanes], LaneDerivative[NumLanes];
+			ZX.Store(LaneX);
+			ZY.Store(LaneY);
+			ZZ.Store(LaneZ);
+			Derivative.Store(LaneDerivative);
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				if (!(PerturbedBits & (1 << Lane)))
+				{
+					continue;
+				}
+
+				// The reference escaped before MaxIterations but this sample is still bounded: the orbit ran out under it
+				const double Radius = FVector3d(LaneX[Lane], LaneY[Lane], LaneZ[Lane]).Length();
+				bool bGlitched = (GlitchedBits & (1 << Lane)) != 0;
+				if (Iterations[Lane] >= MaxPerturbIterations && MaxPerturbIterations < MaxIterations && Radius <= this->BailoutRadius)
+				{
+					bGlitched = true;
+				}
+
+				OutResults[Lane] = MakeDEResult(Radius, LaneDerivative[Lane], Iterations[Lane]);
+				OutResults[Lane].bGlitched = bGlitched;
+			}
+		}
+	};
+
+	// ShadeFractal and the coverage RenderFractal gives each outcome
+	FLinearColor ShadeFractal(const FCpuMarchResult& Result, const FFractalParameter& Parameters)
+	{
+		const double MaxRaySteps = FMath::Max(static_cast<double>(Parameters.MaxRaySteps), 1.0);
+		const double StepFactor = Result.Steps > 0 ? FMath::Clamp(Result.Steps / MaxRaySteps, 0.0, 1.0) : 0.0;
+		const double T = FMath::Sqrt(StepFactor);
+
+		const FVector3d AlmostBlack(0.0, 0.0, 0.05);
+		const FVector3d DeepBlue(0.05, 0.15, 0.3);
+		const FVector3d VibrantBlue(0.2, 0.4, 0.8);
+		const FVector3d BrightBlue(0.6, 0.8, 1.0);
+
+		const double Range1 = FMath::Clamp(T / 0.15, 0.0, 1.0);
+		const double Range2 = FMath::Clamp((T - 0.15) / (0.4 - 0.15), 0.0, 1.0);
+		const double Range3 = FMath::Clamp((T - 0.4) / (1.0 - 0.4), 0.0, 1.0);
+		FVector3d Color = FMath::Lerp(FMath::Lerp(FMath::Lerp(AlmostBlack, DeepBlue, Range1), VibrantBlue, Range2), BrightBlue, Range3);
+
+		if (Result.Steps > 0)
+		{
+			const double IterationBudget = FMath::Max(static_cast<double>(Parameters.MaxIterations) * Result.Steps, 1.0);
+			const double IterFactor = FMath::Clamp(Result.TotalDEIterations / IterationBudget, 0.0, 1.0);
+
+			constexpr double GreenThreshold = 0.1;
+			if (IterFactor > GreenThreshold)
+			{
+				const double GreenAmount = FMath::Square((IterFactor - GreenThreshold) / (1.0 - GreenThreshold));
+				Color = FMath::Lerp(Color, FVector3d(0.3, 0.5, 0.6), GreenAmount);
+			}
+
+			constexpr double GreenPeak = 0.9;
+			if (IterFactor > GreenPeak)
+			{
+				const double GreenAmount = FMath::Pow((IterFactor - GreenPeak) / (1.0 - GreenPeak), 5.0);
+				Color = FMath::Lerp(Color, FVector3d(0.3, 0.9, 0.7), GreenAmount);
+			}
+		}
+
+		double Coverage = 0.0;
+		switch (Result.HitStatus)
+		{
+		case ECpuHitStatus::Hit:
+		case ECpuHitStatus::MissSteps:
+			Coverage = 1.0;
+			break;
+		case ECpuHitStatus::MissDistance:
+			Coverage = FMath::Pow(StepFactor, 0.1);
+			break;
+		default:
+			return FLinearColor::Transparent;
+		}
+		return FLinearColor(Color.X, Color.Y, Color.Z, Coverage);
+	}
+}
+
+FFractalCpuCamera FFractalCpuCamera::FromMatrices(const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix, FIntPoint InExtent)
+{
+	FFractalCpuCamera Camera;
+	Camera.ViewToWorld = ViewMatrix.Inverse();
+	Camera.ClipToView = ProjectionMatrix.Inverse();
+	Camera.Origin = Camera.ViewToWorld.GetOrigin();
+	Camera.Extent = InExtent;
+	return Camera;
+}
+
+FFractalCpuCamera FFractalCpuCamera::FromViewpoint(const FVector3d& Location, const FRotator& Rotation, double HorizontalFovDegrees, FIntPoint InExtent)
+{
+	// Same construction as FSceneView: world to camera axes, then camera (X forward) to view space (Z forward)
+	const FMatrix ViewMatrix = FTranslationMatrix(-Location) * FInverseRotationMatrix(Rotation) * FMatrix(
+		FPlane(0, 0, 1, 0),
+		FPlane(1, 0, 0, 0),
+		FPlane(0, 1, 0, 0),
+		FPlane(0, 0, 0, 1));
+
+	const double HalfFovRadians = FMath::DegreesToRadians(FMath::Clamp(HorizontalFovDegrees, 1.0, 170.0)) * 0.5;
+	const FMatrix ProjectionMatrix = FReversedZPerspectiveMatrix(HalfFovRadians, static_cast<double>(FMath::Max(InExtent.X, 1)), static_cast<double>(FMath::Max(InExtent.Y, 1)), CameraNearPlane);
+	return FromMatrices(ViewMatrix, ProjectionMatrix, InExtent);
+}
+
+void FFractalCpuCamera::GetRay(const FVector2D& PixelPosition, FVector3d& OutOrigin, FVector3d& OutDirection) const
+{
+	const double NdcX = PixelPosition.X / FMath::Max(Extent.X, 1) * 2.0 - 1.0;
+	const double NdcY = 1.0 - PixelPosition.Y / FMath::Max(Extent.Y, 1) * 2.0;
+
+	FVector4d ViewPosition = ClipToView.TransformFVector4(FVector4d(NdcX, NdcY, 1.0, 1.0));
+	const FVector3d ViewDirection = (FVector3d(ViewPosition) / FMath::Max(ViewPosition.W, 1e-6)).GetSafeNormal();
+
+	OutOrigin = Origin;
+	OutDirection = ViewToWorld.TransformVector(ViewDirection).GetSafeNormal();
+}
+
+double FFractalCpuCamera::GetPixelWorldRadius(double Distance) const
+{
+	return Distance * ClipToView.M[1][1] / FMath::Max(Extent.Y, 1);
+}
+
+TArray<FColor> FFractalCpuImage::ToColors(const FLinearColor& Background) const
+{
+	TArray<FColor> Colors;
+	Colors.SetNumUninitialized(Pixels.Num());
+	for (int32 Index = 0; Index < Pixels.Num(); ++Index)
+	{
+		const FLinearColor& Pixel = Pixels[Index];
+		FLinearColor Composited = FMath::Lerp(Background, Pixel, Pixel.A);
+		Composited.A = 1.0f;
+		Colors[Index] = Composited.ToFColorSRGB();
+	}
+	return Colors;
+}
+
+FFractalCpuRenderer::FFractalCpuRenderer(const FFractalParameter& InParameters, TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> InReferences)
+	: Parameters(InParameters)
+	, References(MoveTemp(InReferences))
+{
+	References.RemoveAll([](const TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>& Orbit) { return !Orbit.IsValid() || !Orbit->IsValid(); });
+}
+
+FFractalCpuImage FFractalCpuRenderer::Render(const FFractalCpuCamera& Camera, const FFractalCpuRenderSettings& Settings) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FractalCpuRender);
+	FRACTAL_TRACE_SCOPE(FFractalCpuRenderer::Render);
+
+	FFractalCpuImage Image;
+	Image.Extent = FIntPoint(FMath::Max(Camera.Extent.X, 0), FMath::Max(Camera.Extent.Y, 0));
+	Image.Pixels.SetNumZeroed(Image.Extent.X * Image.Extent.Y);
+	if (Image.Pixels.IsEmpty())
+	{
+		return Image;
+	}
+
+	TArray<const FReferenceOrbit*> Orbits;
+	for (const TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>& Orbit : References)
+	{
+		Orbits.Add(Orbit.Get());
+	}
+
+	const int32 TileSize = FMath::Max(Settings.TileSize, 1);
+	const FIntPoint NumTiles(FMath::DivideAndRoundUp(Image.Extent.X, TileSize), FMath::DivideAndRoundUp(Image.Extent.Y, TileSize));
+	Image.NumTiles = NumTiles.X * NumTiles.Y;
+
+	TArray<FCpuTileStats> TileStats;
+	TileStats.SetNum(Image.NumTiles);
+
+	Image.bRayPackets = Settings.bUseRayPackets && MandelbulbMath::GetPolynomialPower(Parameters.FractalPower) > 0;
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	MandelbulbMath::DispatchPower(Parameters.FractalPower, [&]<int32 P>()
+	{
+		const TCpuMarcher<P> Marcher(Parameters, Orbits, Camera, Settings.bUseSeriesApproximation);
+
+		// One task per tile: workers that finish early keep taking tiles, so slow regions spread out
+		ParallelFor(TEXT("FractalCpuRender"), Image.NumTiles, 1, [&](int32 Tile)
+		{
+			FCpuTileStats Stats;
+			Stats.ThreadId = FPlatformTLS::GetCurrentThreadId();
+			const double TileStart = FPlatformTime::Seconds();
+
+			const FIntPoint Min((Tile % NumTiles.X) * TileSize, (Tile / NumTiles.X) * TileSize);
+			const FIntPoint Max(FMath::Min(Min.X + TileSize, Image.Extent.X), FMath::Min(Min.Y + TileSize, Image.Extent.Y));
+			const auto RecordPixel = [&](int32 X, int32 Y, const FCpuMarchResult& Result)
+			{
+				Image.Pixels[Y * Image.Extent.X + X] = ShadeFractal(Result, Parameters);
+				Stats.NumSteps += Result.Steps;
+				Stats.NumDEIterations += Result.TotalDEIterations;
+				Stats.NumHits += Result.HitStatus == ECpuHitStatus::Hit ? 1 : 0;
+				Stats.NumDistanceMisses += Result.HitStatus == ECpuHitStatus::MissDistance ? 1 : 0;
+				Stats.NumStepLimited += Result.HitStatus == ECpuHitStatus::MissSteps ? 1 : 0;
+				Stats.NumGlitchedPixels += Result.bGlitched ? 1 : 0;
+			};
+
+			// Packets need the polynomial power map; other powers always march one ray at a time
+			if constexpr (P > 0)
+			{
+				if (Image.bRayPackets)
+				{
+					const TCpuPacketMarcher<P> PacketMarcher(Parameters, Orbits, Camera, Settings.bUseSeriesApproximation);
+					PacketMarcher.MarchTile(Min, Max, RecordPixel);
+				}
+				else
+				{
+					Marcher.MarchTile(Min, Max, RecordPixel);
+				}
+			}
+			else
+			{
+				Marcher.MarchTile(Min, Max, RecordPixel);
+			}
+
+			Stats.Seconds = FPlatformTime::Seconds() - TileStart;
+			TileStats[Tile] = Stats;
+		}, Settings.bSingleThreaded ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+	});
+	Image.WallSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+	TSet<uint32> Threads;
+	for (const FCpuTileStats& Stats : TileStats)
+	{
+		Image.NumSteps += Stats.NumSteps;
+		Image.NumDEIterations += Stats.NumDEIterations;
+		Image.NumHits += Stats.NumHits;
+		Image.NumDistanceMisses += Stats.NumDistanceMisses;
+		Image.NumStepLimited += Stats.NumStepLimited;
+		Image.NumGlitchedPixels += Stats.NumGlitchedPixels;
+		Image.BusySeconds += Stats.Seconds;
+		Threads.Add(Stats.ThreadId);
+	}
+	Image.NumThreads = Threads.Num();
+
+	return Image;
+}
+
+namespace
+{
+	// The running game's fractal subsystem, if there is one (the command also works without a world)
+	UFractalControlSubsystem* FindFractalControlSubsystem()
+	{
+		if (!GEngine)
+		{
+			return nullptr;
+		}
+
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if (Context.OwningGameInstance && Context.World() && Context.World()->IsGameWorld())
+			{
+				if (UFractalControlSubsystem* Subsystem = Context.OwningGameInstance->GetSubsystem<UFractalControlSubsystem>())
+				{
+					return Subsystem;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * What the CPU commands render: in a running game the subsystem's parameters, its published reference
+	 * orbits and the first player's camera; without one (e.g. a -nullrhi CI run) an orbit generated for
+	 * the default parameters and a camera framing the whole bulb.
+	 */
+	void GetCpuRenderScene(const FIntPoint& Extent, FFractalParameter& OutParameters, TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>>& OutReferences, FFractalCpuCamera& OutCamera)
+	{
+		OutParameters = FFractalParameter();
+		OutReferences.Reset();
+		TOptional<FFractalCpuCamera> Camera;
+
+		if (const UFractalControlSubsystem* Subsystem = FindFractalControlSubsystem())
+		{
+			OutParameters = Subsystem->GetFractalParameters();
+			OutReferences = Subsystem->GetReferenceOrbits();
+
+			const UWorld* World = Subsystem->GetGameInstance()->GetWorld();
+			const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+			if (PlayerController && PlayerController->PlayerCameraManager)
+			{
+				const FMinimalViewInfo& View = PlayerController->PlayerCameraManager->GetCameraCacheView();
+				Camera = FFractalCpuCamera::FromViewpoint(View.Location, View.Rotation, View.FOV, Extent);
+			}
+		}
+
+		if (OutReferences.IsEmpty())
+		{
+			const FMandelbulbOrbitGenerator Generator;
+			OutReferences.Add(MakeShared<const FReferenceOrbit, ESPMode::ThreadSafe>(Generator.GenerateOrbit(
+				FVector3d(OutParameters.Center.X, OutParameters.Center.Y, 0.0), OutParameters.FractalPower, OutParameters.MaxIterations, OutParameters.BailoutRadius)));
+		}
+
+		if (!Camera.IsSet())
+		{
+			// The bulb spans about 1.2 fractal units around the origin, i.e. 1.2 / Zoom world units
+			const double FractalToWorld = 1.0 / FMath::Max(static_cast<double>(OutParameters.Zoom), UE_DOUBLE_SMALL_NUMBER);
+			Camera = FFractalCpuCamera::FromViewpoint(FVector3d(-3.0 * FractalToWorld, 0.0, 0.0), FRotator::ZeroRotator, 60.0, Extent);
+		}
+
+		OutCamera = Camera.GetValue();
+	}
+
+	/**
+	 * Fractal.CpuRender [Width] [Height] [TileSize] [File]
+	 * Renders the scene GetCpuRenderScene picks on the CPU and saves it as an image.
+	 * Logs throughput in megapixels per second, overall and per busy core.
+	 */
+	void RenderOnCpu(const TArray<FString>& Args)
+	{
+		const FIntPoint Extent(
+			Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 640,
+			Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 360);
+		FFractalCpuRenderSettings Settings;
+		Settings.TileSize = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : Settings.TileSize;
+		const FString FilePath = Args.Num() > 3 ? Args[3] : FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Fractal"), TEXT("CpuRender.png"));
+
+		FFractalParameter Parameters;
+		TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> References;
+		FFractalCpuCamera Camera;
+		GetCpuRenderScene(Extent, Parameters, References, Camera);
+
+		const FFractalCpuRenderer Renderer(Parameters, MoveTemp(References));
+		const FFractalCpuImage Image = Renderer.Render(Camera, Settings);
+
+		const TArray<FColor> Colors = Image.ToColors();
+		const bool bSaved = FImageUtils::SaveImageByExtension(*FilePath, FImageView(Colors.GetData(), Image.Extent.X, Image.Extent.Y));
+
+		const double NumPixels = static_cast<double>(FMath::Max<int64>(Image.GetNumPixels(), 1));
+		UE_LOG(LogFractalCpuRenderer, Display,
+			TEXT("Fractal.CpuRender: %dx%d in %.2f s on %d threads (%d tiles of %d px, %s). %.3f MP/s, %.3f MP/s per core (%.0f%% parallel efficiency)"),
+			Image.Extent.X, Image.Extent.Y, Image.WallSeconds, Image.NumThreads, Image.NumTiles, Settings.TileSize,
+			Image.bRayPackets ? TEXT("ray packets") : TEXT("scalar"),
+			Image.GetMegapixelsPerSecond(), Image.GetMegapixelsPerSecondPerCore(),
+			100.0 * Image.BusySeconds / FMath::Max(Image.WallSeconds * FMath::Max(Image.NumThreads, 1), 1e-9));
+		UE_LOG(LogFractalCpuRenderer, Display,
+			TEXT("Fractal.CpuRender: %.1f steps/px, %.1f DE iterations/px, %.1f%% hit, %.1f%% distance miss, %.1f%% step-limited, %d glitched pixels"),
+			Image.NumSteps / NumPixels, Image.NumDEIterations / NumPixels,
+			100.0 * Image.NumHits / NumPixels, 100.0 * Image.NumDistanceMisses / NumPixels, 100.0 * Image.NumStepLimited / NumPixels,
+			Image.NumGlitchedPixels);
+		UE_LOG(LogFractalCpuRenderer, Display, TEXT("Fractal.CpuRender: %s %s"), bSaved ? TEXT("saved") : TEXT("FAILED to save"), *FilePath);
+	}
+
+	FAutoConsoleCommand RenderOnCpuCommand(
+		TEXT("Fractal.CpuRender"),
+		TEXT("Render the fractal on the CPU in double precision and save it. Args: [Width=640] [Height=360] [TileSize=16] [File=Saved/Fractal/CpuRender.png]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RenderOnCpu));
+
+	/**
+	 * Fractal.BenchmarkCpuRender [Width] [Height] [Runs]
+	 * Renders the Fractal.CpuRender scene Runs times one ray at a time and Runs times in ray packets,
+	 * interleaved, and logs the best per-core throughput of each and their DE iterations per pixel.
+	 * Fractal.CpuRender.RayPackets (automation) checks that the two frames agree.
+	 */
+	void BenchmarkCpuRender(const TArray<FString>& Args)
+	{
+		const FIntPoint Extent(
+			Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 320,
+			Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 180);
+		const int32 NumRuns = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 3;
+
+		FFractalParameter Parameters;
+		TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> References;
+		FFractalCpuCamera Camera;
+		GetCpuRenderScene(Extent, Parameters, References, Camera);
+		const FFractalCpuRenderer Renderer(Parameters, MoveTemp(References));
+
+		FFractalCpuRenderSettings ScalarSettings;
+		ScalarSettings.bUseRayPackets = false;
+		FFractalCpuRenderSettings PacketSettings;
+		PacketSettings.bUseRayPackets = true;
+
+		FFractalCpuImage ScalarImage;
+		FFractalCpuImage PacketImage;
+		double ScalarBest = 0.0;
+		double PacketBest = 0.0;
+		for (int32 Run = 0; Run < NumRuns; ++Run)
+		{
+			ScalarImage = Renderer.Render(Camera, ScalarSettings);
+			PacketImage = Renderer.Render(Camera, PacketSettings);
+			ScalarBest = FMath::Max(ScalarBest, ScalarImage.GetMegapixelsPerSecondPerCore());
+			PacketBest = FMath::Max(PacketBest, PacketImage.GetMegapixelsPerSecondPerCore());
+		}
+
+		if (!PacketImage.bRayPackets)
+		{
+			UE_LOG(LogFractalCpuRenderer, Display, TEXT("Fractal.BenchmarkCpuRender: power %.2f has no polynomial map, both runs marched one ray at a time"), Parameters.FractalPower);
+		}
+
+		const double NumPixels = static_cast<double>(FMath::Max<int64>(ScalarImage.GetNumPixels(), 1));
+		UE_LOG(LogFractalCpuRenderer, Display,
+			TEXT("Fractal.BenchmarkCpuRender: %dx%d, best of %d. Scalar %.3f MP/s per core, packets %.3f MP/s per core (%.2fx)"),
+			Extent.X, Extent.Y, NumRuns, ScalarBest, PacketBest, PacketBest / FMath::Max(ScalarBest, 1e-9));
+		UE_LOG(LogFractalCpuRenderer, Display,
+			TEXT("Fractal.BenchmarkCpuRender: scalar %.1f, packets %.1f DE iterations/px"),
+			ScalarImage.NumDEIterations / NumPixels, PacketImage.NumDEIterations / NumPixels);
+	}
+
+	FAutoConsoleCommand BenchmarkCpuRenderCommand(
+		TEXT("Fractal.BenchmarkCpuRender"),
+		TEXT("Compare CPU render throughput with and without ray packets. Args: [Width=320] [Height=180] [Runs=3]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkCpuRender));
+}
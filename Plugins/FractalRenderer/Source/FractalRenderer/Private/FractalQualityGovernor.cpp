@@ -0,0 +1,111 @@
+#include "FractalQualityGovernor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFractalGovernor, Log, All);
+
+namespace
+{
+	// Weight of a new sample in the smoothed GPU time
+	constexpr float GpuTimeSmoothing = 0.25f;
+
+	// Largest fraction of the quality a single decision may drop, so one outlier costs at most a quarter of the budgets
+	constexpr float MaxQualityDrop = 0.25f;
+
+	// Changes smaller than this are not worth invalidating the hit history for (it is keyed on MaxIterations)
+	constexpr float MinQualityChange = 0.01f;
+
+	// Floors below which scaled budgets stop being useful
+	constexpr int32 MinGovernedRaySteps = 16;
+	constexpr int32 MinGovernedIterations = 8;
+}
+
+bool FFractalQualityGovernor::Update(float GpuMs, const FFractalQualityGovernorSettings& Settings)
+{
+	SmoothedGpuMs = NumSamples > 0 ? FMath::Lerp(SmoothedGpuMs, GpuMs, GpuTimeSmoothing) : GpuMs;
+	++NumSamples;
+
+	UE_LOG(LogFractalGovernor, VeryVerbose, TEXT("Sample %.3f ms, smoothed %.3f ms, quality %.3f"), GpuMs, SmoothedGpuMs, Quality);
+
+	if (NumSamples < FMath::Max(Settings.CooldownSamples, 1))
+	{
+		return false;
+	}
+
+	const float TargetMs = FMath::Max(Settings.TargetGpuMs, 0.1f);
+	MinResolution = FMath::Clamp(Settings.MinResolution, 0.1f, 1.0f);
+	const float MinQuality = FMath::Clamp(Settings.MinQuality, 0.01f, 1.0f) * FMath::Square(MinResolution);
+
+	const float Band = FMath::Clamp(Settings.Hysteresis, 0.0f, 0.9f);
+	float NewQuality = Quality;
+	const TCHAR* Reason = TEXT("quality range changed");
+	if (SmoothedGpuMs > TargetMs * (1.0f + Band))
+	{
+		// Cost scales roughly with pixels times budgets, so aim straight for the target
+		NewQuality = Quality * FMath::Max(TargetMs / SmoothedGpuMs, 1.0f - MaxQualityDrop);
+		Reason = TEXT("over budget");
+	}
+	else if (SmoothedGpuMs < TargetMs * (1.0f - Band))
+	{
+		NewQuality = Quality + Settings.RecoveryStep;
+		Reason = TEXT("under budget");
+	}
+	NewQuality = FMath::Clamp(NewQuality, MinQuality, 1.0f);
+
+	// The last step back to full quality is always taken, however small
+	const bool bReachesFullQuality = NewQuality == 1.0f && Quality < 1.0f;
+	if (!bReachesFullQuality && FMath::Abs(NewQuality - Quality) < MinQualityChange)
+	{
+		return false;
+	}
+
+	const float OldQuality = Quality;
+	const float OldResolution = GetResolutionScale();
+	const float OldBudget = GetBudgetScale();
+	Quality = NewQuality;
+
+	UE_LOG(LogFractalGovernor, Log, TEXT("%s: smoothed %.3f ms vs target %.3f ms (+/-%.0f%%), quality %.3f -> %.3f (resolution %.2f -> %.2f, budgets %.2f -> %.2f)"),
+		Reason, SmoothedGpuMs, TargetMs, Band * 100.0f, OldQuality, Quality,
+		OldResolution, GetResolutionScale(), OldBudget, GetBudgetScale());
+
+	// Timings already in flight were measured with the old budgets; start the estimate over
+	NumSamples = 0;
+	return true;
+}
+
+FFractalParameter FFractalQualityGovernor::Apply(const FFractalParameter& InParams) const
+{
+	FFractalParameter Params = InParams;
+	if (Quality >= 1.0f)
+	{
+		return Params;
+	}
+
+	Params.ScreenPercentage = InParams.ScreenPercentage * GetResolutionScale();
+
+	const float BudgetScale = GetBudgetScale();
+	if (BudgetScale >= 1.0f)
+	{
+		return Params;
+	}
+
+	Params.MaxRaySteps = FMath::Max(FMath::RoundToInt(InParams.MaxRaySteps * BudgetScale), FMath::Min(InParams.MaxRaySteps, MinGovernedRaySteps));
+	Params.MaxIterations = FMath::Max(FMath::RoundToInt(InParams.MaxIterations * BudgetScale), FMath::Min(InParams.MaxIterations, MinGovernedIterations));
+	Params.MinIterations = FMath::Clamp(FMath::RoundToInt(InParams.MinIterations * BudgetScale), FMath::Min(InParams.MinIterations, 1), Params.MaxIterations);
+
+	// A looser convergence test ends each DE sooner, in step with the smaller iteration budget
+	Params.ConvergenceFactor = InParams.ConvergenceFactor / BudgetScale;
+	return Params;
+}
+
+bool FFractalQualityGovernor::Reset()
+{
+	const bool bChanged = Quality != 1.0f;
+	if (bChanged)
+	{
+		UE_LOG(LogFractalGovernor, Log, TEXT("Reset: quality %.3f -> 1.000"), Quality);
+	}
+
+	Quality = 1.0f;
+	SmoothedGpuMs = 0.0f;
+	NumSamples = 0;
+	return bChanged;
+}
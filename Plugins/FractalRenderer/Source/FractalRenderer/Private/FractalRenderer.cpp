@@ -5,9 +5,12 @@
 #include "ShaderCore.h"
 #include "Misc/CoreDelegates.h"
 #include "Engine/Engine.h"
+#include "FractalStats.h"
 
 #define LOCTEXT_NAMESPACE "FFractalRendererModule"
 
+UE_TRACE_CHANNEL_DEFINE(FractalChannel);
+
 void FFractalRendererModule::StartupModule()
 {
 	// Map the plugin's shader directory
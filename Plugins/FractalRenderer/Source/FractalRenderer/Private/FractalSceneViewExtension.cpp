@@ -10,21 +10,398 @@
 #include "PerturbationShader.h"
 #include "MandelbulbOrbitGenerator.h"
 #include "RHICommandList.h"
+#include "RHIGPUReadback.h"
+#include "HAL/IConsoleManager.h"
+#include "Stats/Stats.h"
+#include "Misc/ScopeExit.h"
+#include "FractalStats.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogFractalViewExtension, Log, All);
 
+DECLARE_CYCLE_STAT(TEXT("Render Thread Setup"), STAT_FractalRenderThread, STATGROUP_Fractal);
+DECLARE_CYCLE_STAT(TEXT("Render Thread Lock Wait"), STAT_FractalLockWait, STATGROUP_Fractal);
+DECLARE_CYCLE_STAT(TEXT("Orbit Packing"), STAT_FractalOrbitPacking, STATGROUP_Fractal);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Orbit Upload Bytes"), STAT_FractalOrbitUploadBytes, STATGROUP_Fractal);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Orbit Uploads"), STAT_FractalOrbitUploads, STATGROUP_Fractal);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Orbit Upload Chunks"), STAT_FractalOrbitUploadChunks, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("March Steps / Pixel"), STAT_FractalMarchStepsPerPixel, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Cone Steps Saved / Pixel"), STAT_FractalConeStepsSavedPerPixel, STATGROUP_Fractal);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cone Prepass Steps"), STAT_FractalConePrepassSteps, STATGROUP_Fractal);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Reprojected Pixels"), STAT_FractalReprojectedPixels, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Fractal GPU Time (ms)"), STAT_FractalGpuTimeMs, STATGROUP_Fractal);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Accumulated Samples"), STAT_FractalAccumulatedSamples, STATGROUP_Fractal);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Hit Pixels"), STAT_FractalHitPixels, STATGROUP_Fractal);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Distance Miss Pixels"), STAT_FractalDistanceMissPixels, STATGROUP_Fractal);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Step-Limited Pixels"), STAT_FractalStepLimitedPixels, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("DE Iterations / Pixel"), STAT_FractalIterationsPerPixel, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Steps p50"), STAT_FractalStepsP50, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Steps p95"), STAT_FractalStepsP95, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("DE Iterations p50"), STAT_FractalIterationsP50, STATGROUP_Fractal);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("DE Iterations p95"), STAT_FractalIterationsP95, STATGROUP_Fractal);
+DECLARE_GPU_STAT_NAMED(FractalRender, TEXT("Fractal"));
+
+TRACE_DECLARE_INT_COUNTER(FractalOrbitUploadBytes, TEXT("Fractal/Orbit Upload Bytes"));
+TRACE_DECLARE_FLOAT_COUNTER(FractalGpuTimeMs, TEXT("Fractal/GPU Time (ms)"));
+
 namespace
 {
-BEGIN_SHADER_PARAMETER_STRUCT(FUploadOrbitDataParameters, )
-	RDG_TEXTURE_ACCESS(OrbitTexture, ERHIAccess::CopyDest)
-END_SHADER_PARAMETER_STRUCT()
+	BEGIN_SHADER_PARAMETER_STRUCT(FUploadOrbitChunkParameters, )
+		RDG_BUFFER_ACCESS(OrbitBuffer, ERHIAccess::CopyDest)
+	END_SHADER_PARAMETER_STRUCT()
+
+	// Frames of glitch readback that may be in flight before new ones are skipped
+	constexpr int32 MaxGlitchReadbacksInFlight = 4;
+
+	// Frames of march counter readback that may be in flight before new ones are skipped
+	constexpr int32 MaxMarchStatsReadbacksInFlight = 4;
+
+	// Frames of march histogram readback that may be in flight before new ones are skipped
+	constexpr int32 MaxMarchHistogramReadbacksInFlight = 4;
+
+	// Timestamp query pairs that may be in flight before frames go unmeasured
+	constexpr int32 MaxPassTimersInFlight = 4;
+
+	// Render thread frames a view's history survives unused, after which its viewport or PIE session is taken as gone
+	constexpr uint64 MaxViewHistoryIdleFrames = 120;
+
+	// Release the histories of views that have not rendered for MaxViewHistoryIdleFrames
+	template<typename HistoryType>
+	void EvictIdleViewHistories(TMap<uint32, TUniquePtr<HistoryType>>& Histories)
+	{
+		for (auto It = Histories.CreateIterator(); It; ++It)
+		{
+			if (GFrameCounterRenderThread - It.Value()->LastUsedFrame > MaxViewHistoryIdleFrames)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	// Glitch buffer layout: pixel count, then an (x, y, z) float triple per recorded sample
+	constexpr int32 GlitchBufferNumElements = 1 + 3 * FRACTAL_MAX_GLITCH_SAMPLES;
+
+	TAutoConsoleVariable<int32> CVarGlitchReadback(
+		TEXT("Fractal.Glitch.Readback"),
+		1,
+		TEXT("Read glitched-pixel reports back from the GPU so secondary reference orbits can be placed (0 disables)."),
+		ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<int32> CVarCompactOrbitEncoding(
+		TEXT("Fractal.Orbit.CompactEncoding"),
+		0,
+		TEXT("Upload reference orbits in the compact block-quantized encoding (12.25 instead of 24 bytes per point).\n")
+		TEXT("Takes effect with the next published primary orbit. Fractal.Orbit.CompactEncodingAccuracy (automation) checks its accuracy."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarTemporalReprojection(
+		TEXT("Fractal.Temporal.Reprojection"),
+		1,
+		TEXT("Start each ray near the surface the previous frame hit, reprojected with its camera (0 marches every ray from the camera)."),
+		ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<float> CVarTemporalBackOff(
+		TEXT("Fractal.Temporal.BackOff"),
+		0.05f,
+		TEXT("Fraction of the reprojected distance a ray backs off by before marching, to absorb camera motion and surface refinement."),
+		ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<float> CVarTemporalDisocclusionThreshold(
+		TEXT("Fractal.Temporal.DisocclusionThreshold"),
+		0.1f,
+		TEXT("Relative depth spread of the reprojected 3x3 neighbourhood past which a pixel counts as disoccluded and marches in full."),
+		ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<int32> CVarResolutionFollowEngine(
+		TEXT("Fractal.Resolution.FollowEngine"),
+		1,
+		TEXT("Scale the fractal's marched resolution by the engine's primary screen percentage, including dynamic resolution, on top of its own ScreenPercentage."),
+		ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<float> CVarUpscaleDepthSigma(
+		TEXT("Fractal.Upscale.DepthSigma"),
+		0.05f,
+		TEXT("Relative ray-distance difference at which the upscaler's weight for a low-resolution texel falls to 1/e; smaller keeps depth edges sharper."),
+		ECVF_RenderThreadSafe);
+
+	// Fraction of the output resolution (OutputViewRect, the scene color's) the fractal is marched at, per axis
+	float GetMarchResolutionFraction(const FSceneView& View, const FIntRect& OutputViewRect, const FFractalParameter& Params)
+	{
+		float Fraction = FMath::Clamp(Params.ScreenPercentage / 100.0f, 0.1f, 1.0f);
+
+		// The primary view rect is what the engine's screen percentage and dynamic resolution picked this frame.
+		// Before primary upscaling the scene color is already at that size, so the share only applies to output
+		// that is still at the unscaled size.
+		if (CVarResolutionFollowEngine.GetValueOnRenderThread() != 0
+			&& View.UnscaledViewRect.Width() > 0
+			&& OutputViewRect.Width() == View.UnscaledViewRect.Width())
+		{
+			Fraction *= FMath::Clamp(static_cast<float>(View.ViewRect.Width()) / View.UnscaledViewRect.Width(), 0.1f, 1.0f);
+		}
+		return FMath::Max(Fraction, 0.1f);
+	}
+
+	// Parameters that move the fractal surface in world space; any change makes the hit history meaningless
+	// MaxIterations is left out: the quality governor changes it on its own, and resetting the history each time
+	// would make the frame after every decision a full march. Callers compare the configured iteration count instead.
+	bool HasSameSurface(const FFractalParameter& A, const FFractalParameter& B)
+	{
+		return A.Center == B.Center
+			&& A.Zoom == B.Zoom
+			&& A.FractalPower == B.FractalPower
+			&& A.BailoutRadius == B.BailoutRadius
+			&& A.MaxRayDistance == B.MaxRayDistance;
+	}
+
+	TAutoConsoleVariable<int32> CVarConePrepass(
+		TEXT("Fractal.ConePrepass"),
+		1,
+		TEXT("March one cone per tile at low resolution first and start every ray of the tile at the distance it found free (0 marches every ray from the camera).\n")
+		TEXT("Set per scalability level in DefaultScalability.ini."),
+		ECVF_Scalability | ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<int32> CVarConePrepassTileSize(
+		TEXT("Fractal.ConePrepass.TileSize"),
+		8,
+		TEXT("Pixels per side of a cone prepass tile (4 marches the prepass at 1/4 resolution, 8 at 1/8; clamped to 2-16).\n")
+		TEXT("Smaller tiles reach closer to the surface but cost more prepass steps."),
+		ECVF_Scalability | ECVF_RenderThreadSafe);
+
+	// Tile size of this frame's cone prepass, or 0 when it is off
+	int32 GetConePrepassTileSize()
+	{
+		return CVarConePrepass.GetValueOnRenderThread() != 0 ? FMath::Clamp(CVarConePrepassTileSize.GetValueOnRenderThread(), 2, 16) : 0;
+	}
+
+	TAutoConsoleVariable<int32> CVarOrbitUploadChunkPoints(
+		TEXT("Fractal.Orbit.UploadChunkPoints"),
+		65536,
+		TEXT("Orbit points per streamed upload chunk. New orbits are uploaded a chunk at a time and become usable as chunks land."),
+		ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<int32> CVarOrbitUploadBudgetKB(
+		TEXT("Fractal.Orbit.UploadBudgetKB"),
+		2048,
+		TEXT("Orbit upload budget per frame in KB. At least one chunk is uploaded every frame until the orbit is resident."),
+		ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<int32> CVarAccumulation(
+		TEXT("Fractal.Accumulation"),
+		1,
+		TEXT("While the camera, parameters and orbit stay unchanged, average one jittered sample per frame into the fractal (0 marches every frame afresh)."),
+		ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<int32> CVarAccumulationMaxSamples(
+		TEXT("Fractal.Accumulation.MaxSamples"),
+		64,
+		TEXT("Samples after which an unchanged view stops marching and only composites its accumulated image."),
+		ECVF_RenderThreadSafe);
+
+	// Everything in the parameters that shows in the image; any change restarts the accumulation
+	bool HasSameImage(const FFractalParameter& A, const FFractalParameter& B)
+	{
+		return HasSameSurface(A, B)
+			&& A.MaxIterations == B.MaxIterations
+			&& A.ScreenPercentage == B.ScreenPercentage
+			&& A.MaxRaySteps == B.MaxRaySteps
+			&& A.MinIterations == B.MinIterations
+			&& A.ConvergenceFactor == B.ConvergenceFactor
+			&& A.OrbitPrecision == B.OrbitPrecision;
+	}
+
+	// Radical inverse of Index in Base, the Halton sequence
+	float Halton(int32 Index, int32 Base)
+	{
+		float Result = 0.0f;
+		float Fraction = 1.0f;
+		while (Index > 0)
+		{
+			Fraction /= Base;
+			Result += Fraction * (Index % Base);
+			Index /= Base;
+		}
+		return Result;
+	}
+
+	// Sub-pixel offset of an accumulation sample; the first one goes through the pixel center like an unaccumulated frame
+	FVector2f GetSampleJitter(int32 SampleIndex)
+	{
+		return SampleIndex > 0
+			? FVector2f(Halton(SampleIndex, 2) - 0.5f, Halton(SampleIndex, 3) - 0.5f)
+			: FVector2f::ZeroVector;
+	}
+
+	TAutoConsoleVariable<int32> CVarMarchHistogram(
+		TEXT("Fractal.Debug.MarchHistogram"),
+		0,
+		TEXT("Record every pixel's steps, DE iterations and hit status, reduce them to histograms and show them in stat Fractal.\n")
+		TEXT("Read back asynchronously a few frames late; accumulation is off while it is set, so every frame is measured."),
+		ECVF_RenderThreadSafe);
+
+	TAutoConsoleVariable<int32> CVarHeatmap(
+		TEXT("Fractal.Debug.Heatmap"),
+		0,
+		TEXT("Replace the fractal's shading with a heatmap: 0 off, 1 march steps, 2 DE iterations (log scale), 3 hit status\n")
+		TEXT("(green hit, blue miss at MaxRayDistance, red out of steps). Accumulation is off while it is set."),
+		ECVF_RenderThreadSafe);
+
+	// Histogram buckets per unit of log2(1 + DE iterations), so the last bucket ends at MaxRaySteps * MaxIterations
+	float GetIterationBucketScale(int32 MaxRaySteps, int32 MaxIterations)
+	{
+		const double MaxPixelIterations = FMath::Max(double(MaxRaySteps) * double(MaxIterations), 1.0);
+		return static_cast<float>(FRACTAL_MARCH_HISTOGRAM_BUCKETS / FMath::Log2(1.0 + MaxPixelIterations));
+	}
+
+	// Value below which Fraction of the counted pixels lie; BucketStart(Bucket) is the smallest value of a bucket
+	// (and BucketStart(NumBuckets) the end of the last), assuming values spread evenly within each bucket
+	float GetBucketPercentile(const TArray<uint32>& Buckets, float Fraction, TFunctionRef<float(int32)> BucketStart)
+	{
+		uint64 NumCounted = 0;
+		for (const uint32 Count : Buckets)
+		{
+			NumCounted += Count;
+		}
+		if (NumCounted == 0)
+		{
+			return 0.0f;
+		}
+
+		const double Target = FMath::Clamp(Fraction, 0.0f, 1.0f) * double(NumCounted);
+		uint64 Below = 0;
+		for (int32 Bucket = 0; Bucket < Buckets.Num(); ++Bucket)
+		{
+			if (Buckets[Bucket] > 0 && Below + Buckets[Bucket] >= Target)
+			{
+				const float Alpha = static_cast<float>((Target - Below) / Buckets[Bucket]);
+				return FMath::Lerp(BucketStart(Bucket), BucketStart(Bucket + 1), Alpha);
+			}
+			Below += Buckets[Bucket];
+		}
+		return BucketStart(Buckets.Num());
+	}
+
+	// Unpack a FRACTAL_MARCH_HISTOGRAM_SIZE readback marched with the given budgets
+	FFractalMarchHistogram DecodeMarchHistogram(const uint32* Data, int32 MaxRaySteps, int32 MaxIterations)
+	{
+		constexpr int32 StatusOffset = 2 * FRACTAL_MARCH_HISTOGRAM_BUCKETS;
+		constexpr int32 TotalsOffset = StatusOffset + FRACTAL_MARCH_HISTOGRAM_HIT_STATUSES;
+
+		FFractalMarchHistogram Histogram;
+		Histogram.MaxRaySteps = MaxRaySteps;
+		Histogram.MaxIterations = MaxIterations;
+		Histogram.StepBuckets = TArray<uint32>(Data, FRACTAL_MARCH_HISTOGRAM_BUCKETS);
+		Histogram.IterationBuckets = TArray<uint32>(Data + FRACTAL_MARCH_HISTOGRAM_BUCKETS, FRACTAL_MARCH_HISTOGRAM_BUCKETS);
+
+		// Hit statuses in shader order: none, hit, miss at MaxRayDistance, out of steps
+		Histogram.NumPixels = Data[StatusOffset] + Data[StatusOffset + 1] + Data[StatusOffset + 2] + Data[StatusOffset + 3];
+		Histogram.NumHits = Data[StatusOffset + 1];
+		Histogram.NumDistanceMisses = Data[StatusOffset + 2];
+		Histogram.NumStepLimited = Data[StatusOffset + 3];
+		Histogram.TotalSteps = uint64(Data[TotalsOffset]) | (uint64(Data[TotalsOffset + 1]) << 32);
+		Histogram.TotalIterations = uint64(Data[TotalsOffset + 2]) | (uint64(Data[TotalsOffset + 3]) << 32);
+		return Histogram;
+	}
+
+	// Readback slots are reused out of order, so the newest finished one is picked by submission index. Every finished
+	// slot is released; only the newest is locked, and Decode(Slot, Data) runs while it is. False when none decoded.
+	template<typename SlotType, typename DecodeType>
+	bool DecodeNewestReadback(TArray<SlotType>& Slots, uint32 NumBytes, DecodeType&& Decode)
+	{
+		SlotType* Newest = nullptr;
+		for (SlotType& Slot : Slots)
+		{
+			if (!Slot.bInFlight || !Slot.Readback->IsReady())
+			{
+				continue;
+			}
+
+			Slot.bInFlight = false;
+			if (!Newest || Slot.SubmitIndex > Newest->SubmitIndex)
+			{
+				Newest = &Slot;
+			}
+		}
+
+		if (!Newest)
+		{
+			return false;
+		}
+
+		const uint32* Data = static_cast<const uint32*>(Newest->Readback->Lock(NumBytes));
+		if (Data)
+		{
+			Decode(*Newest, Data);
+		}
+		Newest->Readback->Unlock();
+		return Data != nullptr;
+	}
+
+	// FScopeLock for the render thread that counts its wait in stat Fractal and the frame's render thread stats
+	class FCountedScopeLock
+	{
+	public:
+		UE_NONCOPYABLE(FCountedScopeLock);
+
+		FCountedScopeLock(FCriticalSection& InMutex, double& InOutWaitSeconds)
+			: Mutex(InMutex)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FractalLockWait);
+			const double StartSeconds = FPlatformTime::Seconds();
+			Mutex.Lock();
+			InOutWaitSeconds += FPlatformTime::Seconds() - StartSeconds;
+		}
+
+		~FCountedScopeLock()
+		{
+			Mutex.Unlock();
+		}
+
+	private:
+		FCriticalSection& Mutex;
+	};
+
+	// Cleared 1x1 stand-in for a texture input a pass does not use this frame
+	FRDGTextureRef CreateDummyTexture(FRDGBuilder& GraphBuilder, EPixelFormat Format, const TCHAR* Name)
+	{
+		FRDGTextureRef Texture = GraphBuilder.CreateTexture(
+			FRDGTextureDesc::Create2D(FIntPoint(1, 1), Format, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+			Name);
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(Texture), FLinearColor::Transparent);
+		return Texture;
+	}
+}
+
+float FFractalMarchHistogram::GetStepPercentile(float Fraction) const
+{
+	const float StepsPerBucket = static_cast<float>(FMath::Max(MaxRaySteps, 1)) / FRACTAL_MARCH_HISTOGRAM_BUCKETS;
+	return GetBucketPercentile(StepBuckets, Fraction, [StepsPerBucket](int32 Bucket) { return Bucket * StepsPerBucket; });
+}
+
+float FFractalMarchHistogram::GetIterationPercentile(float Fraction) const
+{
+	const float Scale = GetIterationBucketScale(MaxRaySteps, MaxIterations);
+	return GetBucketPercentile(IterationBuckets, Fraction, [Scale](int32 Bucket) { return FMath::Exp2(Bucket / Scale) - 1.0f; });
 }
 
 FFractalSceneViewExtension::FFractalSceneViewExtension(const FAutoRegister& AutoRegister)
 	: FSceneViewExtensionBase(AutoRegister)
-	, CurrentReferenceCenter(FVector3d::ZeroVector)
-	, CurrentOrbitLength(0)
-	, bOrbitHasDerivatives(false)
+	, NumGridRows(0)
+	, bCompactOrbitRows(false)
+	, OrbitDataGeneration(0)
+	, LastOrbitRowVersion(0)
+	, CurrentOrbitVersion(0)
+	, NumGlitchReadbacksSubmitted(0)
+	, bHasPendingGlitchReport(false)
+	, NumMarchStatsSubmitted(0)
+	, NumMarchHistogramsSubmitted(0)
+	, bHasMarchStats(false)
+	, bHasMarchHistogram(false)
+	, NumPassTimersSubmitted(0)
+	, PendingGpuTimeMs(0.0f)
+	, bHasPendingGpuTime(false)
+	, LatestGpuMs(0.0f)
+	, RenderLockWaitSeconds(0.0)
+	, RenderUploadBytes(0)
+	, bHasLastViewFrustum(false)
 {
 }
 
@@ -47,38 +424,280 @@ void FFractalSceneViewExtension::SubscribeToPostProcessingPass(
 	}
 }
 
-void FFractalSceneViewExtension::SetFractalParameters(const FFractalParameter& InParams)
+void FFractalSceneViewExtension::SetFractalParameters(const FFractalParameter& InParams, int32 InConfiguredIterations)
 {
-	FScopeLock Lock(&ParameterMutex);
-	FractalParameters = InParams;
+	FRenderParameters RenderParameters;
+	RenderParameters.Parameters = InParams;
+	RenderParameters.ConfiguredIterations = InConfiguredIterations;
+
+	// The triple buffer takes a single writer; the lock never contends with the render thread
+	FScopeLock Lock(&ParameterWriteMutex);
+	ParameterBuffer.WriteAndSwap(RenderParameters);
 }
 
-void FFractalSceneViewExtension::SetReferenceOrbit(const FReferenceOrbit& InOrbit)
+void FFractalSceneViewExtension::SetReferenceOrbit(const FReferenceOrbit& InOrbit, uint64 InVersion)
 {
 	FScopeLock Lock(&OrbitMutex);
+
+	// Orbits complete out of order on background tasks; never replace a newer one
+	if (InVersion < CurrentOrbitVersion)
+	{
+		return;
+	}
+	CurrentOrbitVersion = InVersion;
+
+	// Grid and secondary orbits were generated for the previous primary and are meaningless for this one
+	OrbitRows.Reset();
+	NumGridRows = 0;
+
+	// Every row of a snapshot shares one encoding, so it only switches with the primary orbit
+	bCompactOrbitRows = CVarCompactOrbitEncoding.GetValueOnGameThread() != 0;
 	
 	if (InOrbit.IsValid())
 	{
-		// Convert orbit to float format for GPU upload
-		FMandelbulbOrbitGenerator::ConvertOrbitToFloat(InOrbit, OrbitPositionData, OrbitDerivativeData);
-		CurrentReferenceCenter = InOrbit.ReferenceCenter;
-		CurrentOrbitLength = InOrbit.GetLength();
-		bOrbitHasDerivatives = InOrbit.HasDerivatives();
+		// The orbit already carries upload-ready float views; take a flat copy (or encode them), no conversion pass
+		OrbitRows.Add(MakeOrbitRow(InOrbit, bCompactOrbitRows));
+		OrbitRows.Last().Version = ++LastOrbitRowVersion;
 		
 		UE_LOG(LogFractalViewExtension, Verbose, 
-			TEXT("Orbit updated: %d points, Center=(%.6f, %.6f, %.6f)"),
-			CurrentOrbitLength,
-			CurrentReferenceCenter.X, CurrentReferenceCenter.Y, CurrentReferenceCenter.Z
+			TEXT("Orbit updated: v%llu, %d points, Center=(%.6f, %.6f, %.6f)"),
+			CurrentOrbitVersion,
+			InOrbit.GetLength(),
+			InOrbit.ReferenceCenter.X, InOrbit.ReferenceCenter.Y, InOrbit.ReferenceCenter.Z
 		);
 	}
 	else
 	{
 		UE_LOG(LogFractalViewExtension, Warning, TEXT("Invalid orbit provided"));
-		OrbitPositionData.Empty();
-		OrbitDerivativeData.Empty();
-		CurrentOrbitLength = 0;
-		bOrbitHasDerivatives = false;
 	}
+
+	PackOrbitRows();
+}
+
+void FFractalSceneViewExtension::SetGridOrbits(const TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>>& InOrbits, uint64 InPrimaryVersion)
+{
+	FScopeLock Lock(&OrbitMutex);
+
+	if (InPrimaryVersion != CurrentOrbitVersion || OrbitRows.Num() == 0)
+	{
+		return;
+	}
+
+	// Grid orbits that stay keep their rows, so they are neither encoded nor uploaded again
+	TArray<FOrbitRow> PreviousRows;
+	for (int32 Index = 1; Index <= NumGridRows; ++Index)
+	{
+		PreviousRows.Add(MoveTemp(OrbitRows[Index]));
+	}
+	OrbitRows.RemoveAt(1, NumGridRows);
+	NumGridRows = 0;
+	for (const TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>& Orbit : InOrbits)
+	{
+		if (Orbit.IsValid() && Orbit->IsValid() && 1 + NumGridRows < FRACTAL_MAX_REFERENCES)
+		{
+			OrbitRows.Insert(TakeOrMakeOrbitRow(PreviousRows, Orbit), 1 + NumGridRows);
+			++NumGridRows;
+		}
+	}
+	if (OrbitRows.Num() > FRACTAL_MAX_REFERENCES)
+	{
+		OrbitRows.SetNum(FRACTAL_MAX_REFERENCES);
+	}
+
+	PackOrbitRows();
+
+	UE_LOG(LogFractalViewExtension, Verbose, TEXT("Grid orbits updated: v%llu, %d grid references"), CurrentOrbitVersion, NumGridRows);
+}
+
+void FFractalSceneViewExtension::SetSecondaryOrbits(const TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>>& InOrbits, uint64 InPrimaryVersion)
+{
+	FScopeLock Lock(&OrbitMutex);
+
+	if (InPrimaryVersion != CurrentOrbitVersion || OrbitRows.Num() == 0)
+	{
+		return;
+	}
+
+	// Secondary orbits that stay keep their rows, so they are neither encoded nor uploaded again
+	TArray<FOrbitRow> PreviousRows;
+	for (int32 Index = 1 + NumGridRows; Index < OrbitRows.Num(); ++Index)
+	{
+		PreviousRows.Add(MoveTemp(OrbitRows[Index]));
+	}
+	OrbitRows.SetNum(1 + NumGridRows);
+	for (const TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>& Orbit : InOrbits)
+	{
+		if (Orbit.IsValid() && Orbit->IsValid() && OrbitRows.Num() < FRACTAL_MAX_REFERENCES)
+		{
+			OrbitRows.Add(TakeOrMakeOrbitRow(PreviousRows, Orbit));
+		}
+	}
+
+	PackOrbitRows();
+
+	UE_LOG(LogFractalViewExtension, Verbose, TEXT("Secondary orbits updated: v%llu, %d secondary references"), CurrentOrbitVersion, OrbitRows.Num() - 1 - NumGridRows);
+}
+
+bool FFractalSceneViewExtension::ConsumeGlitchReport(FFractalGlitchReport& OutReport)
+{
+	FScopeLock Lock(&GlitchMutex);
+	if (!bHasPendingGlitchReport)
+	{
+		return false;
+	}
+
+	OutReport = MoveTemp(PendingGlitchReport);
+	bHasPendingGlitchReport = false;
+	return true;
+}
+
+bool FFractalSceneViewExtension::GetLastViewFrustum(FFractalViewFrustum& OutFrustum) const
+{
+	FScopeLock Lock(&FrustumMutex);
+	OutFrustum = LastViewFrustum;
+	return bHasLastViewFrustum;
+}
+
+bool FFractalSceneViewExtension::GetLatestMarchStats(FFractalMarchStats& OutStats) const
+{
+	FScopeLock Lock(&MarchStatsMutex);
+	OutStats = LatestMarchStats;
+	return bHasMarchStats;
+}
+
+bool FFractalSceneViewExtension::GetLatestMarchHistogram(FFractalMarchHistogram& OutHistogram) const
+{
+	FScopeLock Lock(&MarchStatsMutex);
+	OutHistogram = LatestMarchHistogram;
+	return bHasMarchHistogram;
+}
+
+bool FFractalSceneViewExtension::GetLatestRenderThreadStats(FFractalRenderThreadStats& OutStats) const
+{
+	FScopeLock Lock(&RenderStatsMutex);
+	OutStats = LatestRenderThreadStats;
+	return LatestRenderThreadStats.RenderThreadMs > 0.0f;
+}
+
+bool FFractalSceneViewExtension::ConsumeGpuTime(float& OutMilliseconds)
+{
+	FScopeLock Lock(&GpuTimeMutex);
+	if (!bHasPendingGpuTime)
+	{
+		return false;
+	}
+
+	OutMilliseconds = PendingGpuTimeMs;
+	bHasPendingGpuTime = false;
+	return true;
+}
+
+FFractalSceneViewExtension::FOrbitRow FFractalSceneViewExtension::MakeOrbitRow(const FReferenceOrbit& InOrbit, bool bCompact)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FractalOrbitPacking);
+	FRACTAL_TRACE_SCOPE(FFractalSceneViewExtension::MakeOrbitRow);
+
+	FOrbitRow Row;
+	if (bCompact)
+	{
+		Row.Compact.Encode(InOrbit);
+	}
+	else
+	{
+		const TConstArrayView<FVector3f> GpuPositions = InOrbit.GetGpuPositions();
+		const TConstArrayView<FVector3f> GpuDerivatives = InOrbit.GetGpuDerivatives();
+		Row.Positions.Append(GpuPositions.GetData(), GpuPositions.Num());
+		Row.Derivatives.Append(GpuDerivatives.GetData(), GpuDerivatives.Num());
+	}
+	Row.NumPoints = InOrbit.GetLength();
+	Row.Series = InOrbit.SeriesApproximation.GpuData;
+	Row.ReferenceCenter = InOrbit.ReferenceCenter;
+	Row.bHasDerivatives = InOrbit.HasDerivatives();
+	return Row;
+}
+
+FFractalSceneViewExtension::FOrbitRow FFractalSceneViewExtension::TakeOrMakeOrbitRow(TArray<FOrbitRow>& PreviousRows, const TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>& Orbit)
+{
+	const int32 Index = PreviousRows.IndexOfByPredicate([&Orbit](const FOrbitRow& Row) { return Row.Source.HasSameObject(Orbit.Get()); });
+	if (Index != INDEX_NONE)
+	{
+		return MoveTemp(PreviousRows[Index]);
+	}
+
+	FOrbitRow Row = MakeOrbitRow(*Orbit, bCompactOrbitRows);
+	Row.Version = ++LastOrbitRowVersion;
+	Row.Source = Orbit;
+	return Row;
+}
+
+void FFractalSceneViewExtension::PackOrbitRows()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FractalOrbitPacking);
+	FRACTAL_TRACE_SCOPE(FFractalSceneViewExtension::PackOrbitRows);
+
+	TSharedRef<FFractalOrbitSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FFractalOrbitSnapshot, ESPMode::ThreadSafe>();
+
+	// The render thread reallocates its orbit buffers once it sees a new generation, and uploads only rows whose version it lacks
+	Snapshot->Generation = ++OrbitDataGeneration;
+	Snapshot->OrbitVersion = CurrentOrbitVersion;
+
+	// Capability flags hold only if every row has the data; rows are packed back to back at their own length
+	// (compact rows at whole blocks, so every row starts on a block boundary)
+	int32 TotalPoints = 0;
+	Snapshot->bCompactEncoding = bCompactOrbitRows;
+	Snapshot->bHasDerivatives = OrbitRows.Num() > 0;
+	Snapshot->bHasSeriesApproximation = OrbitRows.Num() > 0;
+	for (const FOrbitRow& Row : OrbitRows)
+	{
+		const int32 NumElements = bCompactOrbitRows ? Row.Compact.Positions.Num() : Row.Positions.Num();
+		TotalPoints += NumElements;
+		Snapshot->bHasDerivatives &= Row.bHasDerivatives && (bCompactOrbitRows || Row.Derivatives.Num() == NumElements);
+		Snapshot->bHasSeriesApproximation &= Row.Series.Num() == FOrbitSeriesApproximation::NumRadiusBuckets * FOrbitSeriesApproximation::TexelsPerBucket;
+	}
+
+	if (bCompactOrbitRows)
+	{
+		Snapshot->CompactPositionData.Reserve(TotalPoints);
+		Snapshot->CompactScaleData.Reserve(Snapshot->bHasDerivatives ? TotalPoints : 0);
+		Snapshot->CompactBlockData.Reserve(TotalPoints / FCompactOrbitEncoding::PointsPerBlock);
+	}
+	else
+	{
+		Snapshot->PositionData.Reserve(TotalPoints);
+		Snapshot->DerivativeData.Reserve(Snapshot->bHasDerivatives ? TotalPoints : 0);
+	}
+
+	for (const FOrbitRow& Row : OrbitRows)
+	{
+		if (bCompactOrbitRows)
+		{
+			Snapshot->RowOffsets.Add(static_cast<uint32>(Snapshot->CompactPositionData.Num()));
+			Snapshot->CompactPositionData.Append(Row.Compact.Positions);
+			Snapshot->CompactBlockData.Append(Row.Compact.Blocks);
+			if (Snapshot->bHasDerivatives)
+			{
+				Snapshot->CompactScaleData.Append(Row.Compact.Scales);
+			}
+		}
+		else
+		{
+			Snapshot->RowOffsets.Add(static_cast<uint32>(Snapshot->PositionData.Num()));
+			Snapshot->PositionData.Append(Row.Positions);
+			if (Snapshot->bHasDerivatives)
+			{
+				Snapshot->DerivativeData.Append(Row.Derivatives);
+			}
+		}
+		if (Snapshot->bHasSeriesApproximation)
+		{
+			Snapshot->SeriesData.Append(Row.Series);
+		}
+		Snapshot->ReferenceCenters.Add(FVector4f(FVector3f(Row.ReferenceCenter), static_cast<float>(Row.NumPoints)));
+		Snapshot->RowVersions.Add(Row.Version);
+	}
+
+	// Snapshots are never modified after this point, so the render thread can hold on to one without copying
+	OrbitSnapshots.WriteAndSwap(Snapshot);
 }
 
 FScreenPassTexture FFractalSceneViewExtension::RenderFractal_RenderThread(
@@ -87,12 +706,37 @@ FScreenPassTexture FFractalSceneViewExtension::RenderFractal_RenderThread(
 	const FPostProcessMaterialInputs& Inputs)
 {
 	check(IsInRenderingThread());
+	SCOPE_CYCLE_COUNTER(STAT_FractalRenderThread);
+	FRACTAL_TRACE_SCOPE(FFractalSceneViewExtension::RenderFractal_RenderThread);
+
+	// Setup cost, lock waits and uploads of this view, published however the function returns
+	const double StartSeconds = FPlatformTime::Seconds();
+	RenderLockWaitSeconds = 0.0;
+	RenderUploadBytes = 0;
+	ON_SCOPE_EXIT
+	{
+		TRACE_COUNTER_SET(FractalOrbitUploadBytes, RenderUploadBytes);
+
+		FScopeLock Lock(&RenderStatsMutex);
+		LatestRenderThreadStats.RenderThreadMs = static_cast<float>((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+		LatestRenderThreadStats.LockWaitMs = static_cast<float>(RenderLockWaitSeconds * 1000.0);
+		LatestRenderThreadStats.UploadBytes = RenderUploadBytes;
+		LatestRenderThreadStats.GpuMs = LatestGpuMs;
+	};
 
-	FFractalParameter CurrentParams;
+	// Newest published parameters and orbit snapshot; the read slots belong to this thread until the next swap
+	if (ParameterBuffer.IsDirty())
 	{
-		FScopeLock Lock(&ParameterMutex);
-		CurrentParams = FractalParameters;
+		ParameterBuffer.SwapReadBuffers();
 	}
+	const FFractalParameter& CurrentParams = ParameterBuffer.Read().Parameters;
+	const int32 ConfiguredIterations = ParameterBuffer.Read().ConfiguredIterations;
+
+	if (OrbitSnapshots.IsDirty())
+	{
+		OrbitSnapshots.SwapReadBuffers();
+	}
+	const TSharedPtr<const FFractalOrbitSnapshot, ESPMode::ThreadSafe> OrbitSnapshot = OrbitSnapshots.Read();
 
 	if (!CurrentParams.bEnabled)
 	{
@@ -107,6 +751,9 @@ FScreenPassTexture FFractalSceneViewExtension::RenderFractal_RenderThread(
 		return FScreenPassTexture(SceneColorSlice);
 	}
 
+	RDG_EVENT_SCOPE(GraphBuilder, "Fractal");
+	RDG_GPU_STAT_SCOPE(GraphBuilder, FractalRender);
+
 	const FScreenPassTexture SceneColor = FScreenPassTexture::CopyFromSlice(GraphBuilder, SceneColorSlice);
 
 	if (!SceneColor.IsValid())
@@ -139,10 +786,30 @@ FScreenPassTexture FFractalSceneViewExtension::RenderFractal_RenderThread(
 	
 	FRDGTextureRef OutputTexture = GraphBuilder.CreateTexture(OutputDesc, TEXT("FractalOutput"));
 
+	// Below output resolution, or when accumulating, the march writes (color, coverage) to its own texture that
+	// the resolve pass brings to output resolution
+	const float ResolutionFraction = GetMarchResolutionFraction(View, SceneColor.ViewRect, CurrentParams);
+	const FIntPoint MarchExtent(
+		FMath::Clamp(FMath::CeilToInt(OutputExtent.X * ResolutionFraction), 1, OutputExtent.X),
+		FMath::Clamp(FMath::CeilToInt(OutputExtent.Y * ResolutionFraction), 1, OutputExtent.Y));
+	const bool bUpscale = MarchExtent != OutputExtent;
+	// Debug views need every frame marched, so they turn accumulation off
+	const int32 HeatmapMode = FMath::Clamp(CVarHeatmap.GetValueOnRenderThread(), 0, 3);
+	const bool bMarchHistogram = CVarMarchHistogram.GetValueOnRenderThread() != 0;
+	// Views without a view state share key 0, so they cannot keep an average of their own
+	const bool bAccumulate = CVarAccumulation.GetValueOnRenderThread() != 0 && HeatmapMode == 0 && !bMarchHistogram && View.State != nullptr;
+	const bool bResolve = bUpscale || bAccumulate;
+
+	FRDGTextureRef MarchTexture = bResolve
+		? GraphBuilder.CreateTexture(
+			FRDGTextureDesc::Create2D(MarchExtent, PF_FloatRGBA, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+			TEXT("FractalMarchColor"))
+		: OutputTexture;
+
 	// Allocate shader parameters
 	auto* PassParameters = GraphBuilder.AllocParameters<FPerturbationComputeShader::FParameters>();
 	PassParameters->Center = FVector2f(CurrentParams.Center);
-	PassParameters->OutputSize = OutputExtent;
+	PassParameters->OutputSize = MarchExtent;
 	PassParameters->Zoom = CurrentParams.Zoom;
 	PassParameters->MaxRaySteps = CurrentParams.MaxRaySteps;
 	PassParameters->MaxRayDistance = CurrentParams.MaxRayDistance;
@@ -155,9 +822,10 @@ FScreenPassTexture FFractalSceneViewExtension::RenderFractal_RenderThread(
 	const FRDGTextureDesc& SceneColorDesc = SceneColor.Texture->Desc;
 	const FIntPoint TextureExtent = SceneColorDesc.Extent;
 	const FIntPoint ViewMin = SceneColor.ViewRect.Min;
-	const FVector2f InvViewSize = FVector2f(1.0f / SceneColor.ViewRect.Width(), 1.0f / SceneColor.ViewRect.Height());
+	const FVector2f InvViewSize = FVector2f(1.0f / MarchExtent.X, 1.0f / MarchExtent.Y);
 
-	PassParameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+	PassParameters->OutputTexture = GraphBuilder.CreateUAV(MarchTexture);
+	PassParameters->ComposeBackground = bResolve ? 0 : 1;
 	PassParameters->BackgroundTexture = SceneColor.Texture;
 	PassParameters->BackgroundSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
 	PassParameters->BackgroundExtent = FVector2f(TextureExtent.X, TextureExtent.Y);
@@ -166,58 +834,228 @@ FScreenPassTexture FFractalSceneViewExtension::RenderFractal_RenderThread(
 	PassParameters->ClipToView = FMatrix44f(View.ViewMatrices.GetInvProjectionMatrix());
 	PassParameters->ViewToWorld = FMatrix44f(View.ViewMatrices.GetInvViewMatrix());
 	PassParameters->CameraOrigin = (FVector3f)View.ViewMatrices.GetViewOrigin();
-	PassParameters->ViewSize = FVector2f(SceneColor.ViewRect.Width(), SceneColor.ViewRect.Height());
+	PassParameters->ViewSize = FVector2f(MarchExtent.X, MarchExtent.Y);
 	PassParameters->InvViewSize = InvViewSize;
 
-	// Create and upload orbit texture
-	FRDGTextureRef OrbitTexture = nullptr;
-	TArray<FVector4f> LocalOrbitPositionData;
-	TArray<FVector4f> LocalOrbitDerivativeData;
-	FVector3d LocalReferenceCenter;
-	int32 LocalOrbitLength = 0;
-	bool bLocalHasDerivatives = false;
-	
+	// Remember the camera so the subsystem can spread grid reference orbits over what is being marched
 	{
-		FScopeLock Lock(&OrbitMutex);
-		LocalOrbitPositionData = OrbitPositionData;
-		LocalOrbitDerivativeData = OrbitDerivativeData;
-		LocalReferenceCenter = CurrentReferenceCenter;
-		LocalOrbitLength = CurrentOrbitLength;
-		bLocalHasDerivatives = bOrbitHasDerivatives;
+		const FMatrix& InvViewMatrix = View.ViewMatrices.GetInvViewMatrix();
+		const FMatrix& ProjectionMatrix = View.ViewMatrices.GetProjectionMatrix();
+
+		FCountedScopeLock Lock(FrustumMutex, RenderLockWaitSeconds);
+		LastViewFrustum.Origin = View.ViewMatrices.GetViewOrigin();
+		LastViewFrustum.Right = InvViewMatrix.GetUnitAxis(EAxis::X);
+		LastViewFrustum.Up = InvViewMatrix.GetUnitAxis(EAxis::Y);
+		LastViewFrustum.Forward = InvViewMatrix.GetUnitAxis(EAxis::Z);
+		LastViewFrustum.TanHalfFovX = 1.0 / FMath::Max(ProjectionMatrix.M[0][0], UE_DOUBLE_SMALL_NUMBER);
+		LastViewFrustum.TanHalfFovY = 1.0 / FMath::Max(ProjectionMatrix.M[1][1], UE_DOUBLE_SMALL_NUMBER);
+		bHasLastViewFrustum = true;
 	}
-	(void)LocalOrbitDerivativeData; // Placeholder until derivative textures are uploaded
-	(void)bLocalHasDerivatives; // Derivative sampling will be hooked up in a later task
-	
-	if (LocalOrbitLength > 0 && LocalOrbitPositionData.Num() > 0)
+
+	// Orbit buffers persist across frames and are only re-uploaded when the packed data changes
+	UpdateOrbitGpuResources(GraphBuilder, OrbitSnapshot);
+
+	// Resolve pass: resamples the march (or the converged average) to output resolution, optionally folds it into
+	// the view's accumulation, and composites it over the full-resolution scene color
+	TShaderMapRef<FFractalUpscaleCS> UpscaleShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+	const auto AllocResolveParameters = [&GraphBuilder, &SceneColor, OutputTexture, OutputExtent, PassParameters]()
+	{
+		FFractalUpscaleCS::FParameters* ResolveParameters = GraphBuilder.AllocParameters<FFractalUpscaleCS::FParameters>();
+		ResolveParameters->OutputSize = OutputExtent;
+		ResolveParameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+		ResolveParameters->BackgroundTexture = SceneColor.Texture;
+		ResolveParameters->BackgroundSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+		ResolveParameters->BackgroundInvExtent = PassParameters->BackgroundInvExtent;
+		ResolveParameters->BackgroundViewMin = PassParameters->BackgroundViewMin;
+		ResolveParameters->CameraOrigin = PassParameters->CameraOrigin;
+		ResolveParameters->DepthSigma = FMath::Max(CVarUpscaleDepthSigma.GetValueOnRenderThread(), 1e-4f);
+		ResolveParameters->InputJitter = FVector2f::ZeroVector;
+		ResolveParameters->AccumulationWeight = 1.0f;
+		ResolveParameters->Accumulate = 0;
+		return ResolveParameters;
+	};
+
+	// Progressive refinement: the average restarts whenever the camera, the parameters, either resolution or the
+	// resident orbit data change; otherwise every frame adds one jittered sample until MaxSamples
+	EvictIdleViewHistories(Accumulations);
+	FAccumulationHistory* Accumulation = nullptr;
+	if (bAccumulate)
+	{
+		TUniquePtr<FAccumulationHistory>& Entry = Accumulations.FindOrAdd(View.GetViewKey());
+		if (!Entry.IsValid())
+		{
+			Entry = MakeUnique<FAccumulationHistory>();
+		}
+		Entry->LastUsedFrame = GFrameCounterRenderThread;
+		Accumulation = Entry.Get();
+	}
+	const uint64 OrbitGeneration = OrbitGpu.Snapshot.IsValid() ? OrbitGpu.Snapshot->Generation : 0;
+	const bool bSameImage = Accumulation
+		&& Accumulation->Texture.IsValid()
+		&& Accumulation->ViewMatrix == View.ViewMatrices.GetViewMatrix()
+		&& Accumulation->ProjectionMatrix == View.ViewMatrices.GetProjectionNoAAMatrix()
+		&& Accumulation->OutputExtent == OutputExtent
+		&& Accumulation->MarchExtent == MarchExtent
+		&& Accumulation->OrbitGeneration == OrbitGeneration
+		&& Accumulation->NumStreamedPoints == OrbitGpu.NumStreamedPoints
+		&& HasSameImage(Accumulation->Parameters, CurrentParams);
+	if (Accumulation && !bSameImage)
+	{
+		Accumulation->ViewMatrix = View.ViewMatrices.GetViewMatrix();
+		Accumulation->ProjectionMatrix = View.ViewMatrices.GetProjectionNoAAMatrix();
+		Accumulation->OutputExtent = OutputExtent;
+		Accumulation->MarchExtent = MarchExtent;
+		Accumulation->OrbitGeneration = OrbitGeneration;
+		Accumulation->NumStreamedPoints = OrbitGpu.NumStreamedPoints;
+		Accumulation->Parameters = CurrentParams;
+		Accumulation->NumSamples = 0;
+	}
+	SET_DWORD_STAT(STAT_FractalAccumulatedSamples, bAccumulate ? Accumulation->NumSamples : 0);
+
+	// Converged: no march, prepass or readbacks, only the average composited over this frame's scene color
+	const int32 MaxAccumulatedSamples = FMath::Max(CVarAccumulationMaxSamples.GetValueOnRenderThread(), 1);
+	if (bSameImage && Accumulation->NumSamples >= MaxAccumulatedSamples && UpscaleShader.IsValid())
+	{
+		FFractalUpscaleCS::FParameters* ResolveParameters = AllocResolveParameters();
+		ResolveParameters->InputSize = OutputExtent;
+		ResolveParameters->FractalColorTexture = GraphBuilder.RegisterExternalTexture(Accumulation->Texture, TEXT("FractalAccumulation"));
+		ResolveParameters->FractalDepthTexture = CreateDummyTexture(GraphBuilder, PF_A32B32G32R32F, TEXT("DummyFractalDepth"));
+		ResolveParameters->AccumulationTexture = ResolveParameters->FractalColorTexture;
+		ResolveParameters->AccumulationOutput = GraphBuilder.CreateUAV(CreateDummyTexture(GraphBuilder, PF_A32B32G32R32F, TEXT("DummyFractalAccumulation")));
+
+		FComputeShaderUtils::AddPass(
+			GraphBuilder,
+			RDG_EVENT_NAME("FractalResolveAccumulated %dx%d (%d samples)", OutputExtent.X, OutputExtent.Y, Accumulation->NumSamples),
+			UpscaleShader,
+			ResolveParameters,
+			FComputeShaderUtils::GetGroupCount(OutputExtent, FIntPoint(NUM_THREADS_PerturbationShader_X, NUM_THREADS_PerturbationShader_Y)));
+
+		return FScreenPassTexture(OutputTexture, SceneColor.ViewRect);
+	}
+
+	// Sub-pixel position of this frame's rays, in march texels
+	const FVector2f SampleJitter = bAccumulate ? GetSampleJitter(Accumulation->NumSamples) : FVector2f::ZeroVector;
+	PassParameters->SampleJitter = SampleJitter;
+
+	// One buffer row per reference: the primary orbit first, then grid and glitch references.
+	// Each row's valid length grows from 0 to its full length as its chunks land, or starts full when it was copied.
+	const int32 NumReferences = OrbitGpu.NumReferences;
+	for (int32 Reference = 0; Reference < FRACTAL_MAX_REFERENCES; ++Reference)
+	{
+		const bool bBound = Reference < NumReferences;
+		const uint32 RowOffset = bBound ? OrbitGpu.Snapshot->RowOffsets[Reference] : 0u;
+		const uint32 ValidOrbitLength = bBound ? static_cast<uint32>(FMath::Min<int64>(OrbitGpu.RowStreamedPoints[Reference], int64(OrbitGpu.Snapshot->ReferenceCenters[Reference].W))) : 0u;
+		PassParameters->ReferenceCenters[Reference] = bBound ? OrbitGpu.Snapshot->ReferenceCenters[Reference] : FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+		PassParameters->ReferenceOrbitOffsets[Reference] = FUintVector4(RowOffset, ValidOrbitLength, 0u, 0u);
+	}
+	PassParameters->NumReferences = NumReferences;
+
+	// Positions and derivatives are bound to the slots of the snapshot's encoding; the others get stand-ins
+	const bool bCompact = OrbitGpu.CompactBlocks.IsValid();
+	const auto BindOrbitBuffer = [&GraphBuilder, this](const TRefCountPtr<FRDGPooledBuffer>& Buffer, bool bUsed, uint32 BytesPerElement, const TCHAR* Name, const TCHAR* DummyName)
+	{
+		return bUsed && Buffer.IsValid()
+			? GraphBuilder.CreateSRV(GraphBuilder.RegisterExternalBuffer(Buffer, Name))
+			: CreateDummyOrbitBuffer(GraphBuilder, BytesPerElement, DummyName);
+	};
+
+	PassParameters->ReferenceOrbitBuffer = BindOrbitBuffer(OrbitGpu.Positions, !bCompact, sizeof(FVector3f), TEXT("ReferenceOrbitBuffer"), TEXT("DummyOrbitBuffer"));
+	PassParameters->CompactOrbitBuffer = BindOrbitBuffer(OrbitGpu.Positions, bCompact, sizeof(FUintVector2), TEXT("CompactOrbitBuffer"), TEXT("DummyCompactOrbitBuffer"));
+	PassParameters->CompactOrbitBlockBuffer = BindOrbitBuffer(OrbitGpu.CompactBlocks, bCompact, sizeof(FVector4f), TEXT("CompactOrbitBlockBuffer"), TEXT("DummyCompactOrbitBlockBuffer"));
+	PassParameters->OrbitEncoding = bCompact ? 1 : 0;
+
+	// Second orbit resource: per-iteration derivative scale so the shader can skip pow() near the reference
+	PassParameters->ReferenceDerivativeBuffer = BindOrbitBuffer(OrbitGpu.Derivatives, !bCompact, sizeof(FVector3f), TEXT("ReferenceDerivativeBuffer"), TEXT("DummyDerivativeBuffer"));
+	PassParameters->CompactScaleBuffer = BindOrbitBuffer(OrbitGpu.Derivatives, bCompact, sizeof(float), TEXT("CompactScaleBuffer"), TEXT("DummyCompactScaleBuffer"));
+	PassParameters->OrbitHasDerivatives = OrbitGpu.Derivatives.IsValid() ? 1 : 0;
+
+	// Series approximation table: the shader seeds eps and dr at the skip iteration, so it needs the derivative channel too
+	PassParameters->SeriesApproximationBuffer = OrbitGpu.Series.IsValid()
+		? GraphBuilder.CreateSRV(GraphBuilder.RegisterExternalBuffer(OrbitGpu.Series, TEXT("SeriesApproximationBuffer")))
+		: CreateDummyOrbitBuffer(GraphBuilder, sizeof(FVector4f), TEXT("DummySeriesApproximationBuffer"));
+	PassParameters->OrbitHasSeriesApproximation = OrbitGpu.Series.IsValid() ? 1 : 0;
+
+	// Last frame's hits for this view, unless the surface itself moved. Reprojection works in NDC, so history
+	// marched at another resolution (a resize, or dynamic resolution) still seeds this frame.
+	// Views without a view state share key 0 and would overwrite each other's history, so they keep none.
+	EvictIdleViewHistories(DepthHistories);
+	FDepthHistory* History = nullptr;
+	if (View.State)
+	{
+		TUniquePtr<FDepthHistory>& Entry = DepthHistories.FindOrAdd(View.GetViewKey());
+		if (!Entry.IsValid())
+		{
+			Entry = MakeUnique<FDepthHistory>();
+		}
+		Entry->LastUsedFrame = GFrameCounterRenderThread;
+		History = Entry.Get();
+	}
+	const bool bHistoryValid = History
+		&& CVarTemporalReprojection.GetValueOnRenderThread() != 0
+		&& History->Texture.IsValid()
+		&& HasSameSurface(History->Parameters, CurrentParams)
+		&& History->ConfiguredIterations == ConfiguredIterations;
+
+	if (bHistoryValid)
 	{
-		OrbitTexture = CreateOrbitTexture(GraphBuilder, LocalOrbitPositionData);
-		PassParameters->ReferenceOrbitTexture = OrbitTexture;
-		PassParameters->OrbitSampler = TStaticSamplerState<SF_Point, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-		PassParameters->ReferenceCenter = FVector3f(LocalReferenceCenter);
-		PassParameters->OrbitLength = LocalOrbitLength;
+		PassParameters->HistoryTexture = GraphBuilder.RegisterExternalTexture(History->Texture, TEXT("FractalHistory"));
+		PassParameters->PrevTranslatedWorldToClip = History->TranslatedWorldToClip;
+		PassParameters->PrevPreViewTranslation = History->PreViewTranslation;
+		PassParameters->HistorySize = History->Extent;
 	}
 	else
 	{
-		// No orbit data available, create dummy 1x1 texture
-		FRDGTextureDesc DummyDesc = FRDGTextureDesc::Create2D(
-			FIntPoint(1, 1),
-			PF_A32B32G32R32F,
-			FClearValueBinding::Black,
-			TexCreate_ShaderResource | TexCreate_UAV
-		);
-		OrbitTexture = GraphBuilder.CreateTexture(DummyDesc, TEXT("DummyOrbitTexture"));
-		FRDGTextureUAVRef DummyUAV = GraphBuilder.CreateUAV(OrbitTexture);
-		AddClearUAVPass(GraphBuilder, DummyUAV, FLinearColor::Black);
-		
-		PassParameters->ReferenceOrbitTexture = OrbitTexture;
-		PassParameters->OrbitSampler = TStaticSamplerState<SF_Point, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-		PassParameters->ReferenceCenter = FVector3f::ZeroVector;
-		PassParameters->OrbitLength = 0;
+		PassParameters->HistoryTexture = CreateDummyTexture(GraphBuilder, PF_A32B32G32R32F, TEXT("DummyFractalHistory"));
+		PassParameters->PrevTranslatedWorldToClip = FMatrix44f::Identity;
+		PassParameters->PrevPreViewTranslation = FVector3f::ZeroVector;
+		PassParameters->HistorySize = FIntPoint::ZeroValue;
 	}
+	PassParameters->HistoryValid = bHistoryValid ? 1 : 0;
+	// Fewer DE iterations than the history was marched with let the surface grow towards the camera, so a governor
+	// step down backs off twice as far for the one frame before the history carries the new count
+	const float BackOffScale = bHistoryValid && CurrentParams.MaxIterations < History->Parameters.MaxIterations ? 2.0f : 1.0f;
+	PassParameters->ReprojectionBackOff = FMath::Clamp(CVarTemporalBackOff.GetValueOnRenderThread() * BackOffScale, 0.0f, 1.0f);
+	PassParameters->DisocclusionThreshold = FMath::Max(CVarTemporalDisocclusionThreshold.GetValueOnRenderThread(), 0.0f);
+
+	FRDGTextureRef HistoryOutput = GraphBuilder.CreateTexture(
+		FRDGTextureDesc::Create2D(MarchExtent, PF_A32B32G32R32F, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+		TEXT("FractalHistory"));
+	PassParameters->HistoryOutput = GraphBuilder.CreateUAV(HistoryOutput);
+
+	// Glitch counter and samples; copied back a few frames later when a readback slot is free
+	PollGlitchReadbacks();
+
+	FRDGBufferRef GlitchBuffer = GraphBuilder.CreateBuffer(
+		FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), GlitchBufferNumElements),
+		TEXT("FractalGlitchBuffer"));
+	FRDGBufferUAVRef GlitchBufferUAV = GraphBuilder.CreateUAV(GlitchBuffer);
+	AddClearUAVPass(GraphBuilder, GlitchBufferUAV, 0u);
+	PassParameters->GlitchBuffer = GlitchBufferUAV;
+	PassParameters->MaxGlitchSamples = FRACTAL_MAX_GLITCH_SAMPLES;
+
+	// March counters of both passes, reduced per thread group on the GPU and read back like the glitch report
+	PollMarchStatsReadbacks();
+
+	FRDGBufferRef MarchStatsBuffer = GraphBuilder.CreateBuffer(
+		FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), FRACTAL_NUM_MARCH_STATS),
+		TEXT("FractalMarchStats"));
+	FRDGBufferUAVRef MarchStatsUAV = GraphBuilder.CreateUAV(MarchStatsBuffer);
+	AddClearUAVPass(GraphBuilder, MarchStatsUAV, 0u);
+	PassParameters->MarchStatsBuffer = MarchStatsUAV;
+
+	// Every pixel's (steps, DE iterations, hit status) for the histogram pass; a stand-in UAV when it is off
+	PollMarchHistogramReadbacks();
+
+	FRDGTextureRef MarchDebugTexture = GraphBuilder.CreateTexture(
+		FRDGTextureDesc::Create2D(bMarchHistogram ? MarchExtent : FIntPoint(1, 1), PF_R32G32B32A32_UINT, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+		TEXT("FractalMarchDebug"));
+	PassParameters->MarchDebugOutput = GraphBuilder.CreateUAV(MarchDebugTexture);
+	PassParameters->MarchDebugOutputEnabled = bMarchHistogram ? 1 : 0;
+	PassParameters->HeatmapMode = HeatmapMode;
 
 	const FIntVector GroupCount(
-		FMath::DivideAndRoundUp(OutputExtent.X, NUM_THREADS_PerturbationShader_X),
-		FMath::DivideAndRoundUp(OutputExtent.Y, NUM_THREADS_PerturbationShader_Y),
+		FMath::DivideAndRoundUp(MarchExtent.X, NUM_THREADS_PerturbationShader_X),
+		FMath::DivideAndRoundUp(MarchExtent.Y, NUM_THREADS_PerturbationShader_Y),
 		1);
 
 	const bool bImmediateMode = GraphBuilder.IsImmediateMode();
@@ -227,6 +1065,77 @@ FScreenPassTexture FFractalSceneViewExtension::RenderFractal_RenderThread(
 		return SceneColor;
 	}
 
+	// Timestamps around both fractal passes for the quality governor; without a free pair the frame goes unmeasured
+	PollPassTimers();
+
+	FPassTimer* PassTimer = nullptr;
+	if (GSupportsTimestampRenderQueries)
+	{
+		PassTimer = PassTimers.FindByPredicate([](const FPassTimer& Timer) { return !Timer.bInFlight; });
+		if (!PassTimer && PassTimers.Num() < MaxPassTimersInFlight)
+		{
+			if (!PassTimerQueryPool.IsValid())
+			{
+				PassTimerQueryPool = RHICreateRenderQueryPool(RQT_AbsoluteTime);
+			}
+			PassTimer = &PassTimers.AddDefaulted_GetRef();
+			PassTimer->BeginQuery = PassTimerQueryPool->AllocateQuery();
+			PassTimer->EndQuery = PassTimerQueryPool->AllocateQuery();
+		}
+	}
+
+	const auto AddTimestampPass = [&GraphBuilder](FRHIRenderQuery* Query)
+	{
+		GraphBuilder.AddPass(RDG_EVENT_NAME("FractalTimestamp"), ERDGPassFlags::NeverCull,
+			[Query](FRHICommandListImmediate& RHICmdList)
+			{
+				RHICmdList.EndRenderQuery(Query);
+			});
+	};
+
+	if (PassTimer)
+	{
+		AddTimestampPass(PassTimer->BeginQuery.GetQuery());
+	}
+
+	// Cone prepass: one cone per tile finds the distance every ray of the tile can skip
+	const int32 ConeTileSize = GetConePrepassTileSize();
+	TShaderMapRef<FFractalConeMarchCS> ConeMarchShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+	if (ConeTileSize > 0 && ConeMarchShader.IsValid())
+	{
+		const FIntPoint ConeDepthSize(
+			FMath::DivideAndRoundUp(MarchExtent.X, ConeTileSize),
+			FMath::DivideAndRoundUp(MarchExtent.Y, ConeTileSize));
+		FRDGTextureRef ConeDepth = GraphBuilder.CreateTexture(
+			FRDGTextureDesc::Create2D(ConeDepthSize, PF_G32R32F, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+			TEXT("FractalConeDepth"));
+
+		PassParameters->ConeDepthSize = ConeDepthSize;
+		PassParameters->ConeTileSize = ConeTileSize;
+
+		// Same parameters as the main pass; the prepass writes the cone depths the main pass then reads
+		FFractalConeMarchCS::FParameters* ConeParameters = GraphBuilder.AllocParameters<FFractalConeMarchCS::FParameters>();
+		*ConeParameters = *PassParameters;
+		ConeParameters->ConeDepthOutput = GraphBuilder.CreateUAV(ConeDepth);
+
+		FComputeShaderUtils::AddPass(
+			GraphBuilder,
+			RDG_EVENT_NAME("FractalConePrepass %dx%d", ConeDepthSize.X, ConeDepthSize.Y),
+			ConeMarchShader,
+			ConeParameters,
+			FComputeShaderUtils::GetGroupCount(ConeDepthSize, FIntPoint(NUM_THREADS_PerturbationShader_X, NUM_THREADS_PerturbationShader_Y)));
+
+		PassParameters->ConeDepthTexture = ConeDepth;
+		PassParameters->ConeDepthValid = 1;
+	}
+	else
+	{
+		PassParameters->ConeDepthTexture = CreateDummyTexture(GraphBuilder, PF_G32R32F, TEXT("DummyFractalConeDepth"));
+		PassParameters->ConeDepthSize = FIntPoint(1, 1);
+		PassParameters->ConeTileSize = 1;
+		PassParameters->ConeDepthValid = 0;
+	}
+
 	FComputeShaderUtils::AddPass(
 		GraphBuilder,
 		RDG_EVENT_NAME("RenderFractal"),
@@ -235,73 +1144,578 @@ FScreenPassTexture FFractalSceneViewExtension::RenderFractal_RenderThread(
 		GroupCount
 	);
 
+	// Depth-aware upscale to output resolution and/or accumulation, composited over the full-resolution scene color
+	if (bResolve)
+	{
+		FFractalUpscaleCS::FParameters* ResolveParameters = AllocResolveParameters();
+		ResolveParameters->InputSize = MarchExtent;
+		ResolveParameters->FractalColorTexture = MarchTexture;
+		ResolveParameters->FractalDepthTexture = HistoryOutput;
+
+		// At output resolution every pixel keeps its own jittered sample; an upscale places them where they were taken
+		ResolveParameters->InputJitter = bUpscale ? SampleJitter : FVector2f::ZeroVector;
+
+		if (bAccumulate)
+		{
+			FRDGTextureRef AccumulationOutput = GraphBuilder.CreateTexture(
+				FRDGTextureDesc::Create2D(OutputExtent, PF_A32B32G32R32F, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV),
+				TEXT("FractalAccumulation"));
+			ResolveParameters->AccumulationTexture = Accumulation->NumSamples > 0
+				? GraphBuilder.RegisterExternalTexture(Accumulation->Texture, TEXT("FractalAccumulation"))
+				: CreateDummyTexture(GraphBuilder, PF_A32B32G32R32F, TEXT("DummyFractalAccumulation"));
+			ResolveParameters->AccumulationOutput = GraphBuilder.CreateUAV(AccumulationOutput);
+			ResolveParameters->AccumulationWeight = 1.0f / (Accumulation->NumSamples + 1);
+			ResolveParameters->Accumulate = 1;
+
+			GraphBuilder.QueueTextureExtraction(AccumulationOutput, &Accumulation->Texture);
+			++Accumulation->NumSamples;
+		}
+		else
+		{
+			ResolveParameters->AccumulationTexture = CreateDummyTexture(GraphBuilder, PF_A32B32G32R32F, TEXT("DummyFractalAccumulation"));
+			ResolveParameters->AccumulationOutput = GraphBuilder.CreateUAV(CreateDummyTexture(GraphBuilder, PF_A32B32G32R32F, TEXT("DummyFractalAccumulationOutput")));
+		}
+
+		FComputeShaderUtils::AddPass(
+			GraphBuilder,
+			RDG_EVENT_NAME("FractalResolve %dx%d -> %dx%d", MarchExtent.X, MarchExtent.Y, OutputExtent.X, OutputExtent.Y),
+			UpscaleShader,
+			ResolveParameters,
+			FComputeShaderUtils::GetGroupCount(OutputExtent, FIntPoint(NUM_THREADS_PerturbationShader_X, NUM_THREADS_PerturbationShader_Y)));
+	}
+
+	if (PassTimer)
+	{
+		AddTimestampPass(PassTimer->EndQuery.GetQuery());
+		PassTimer->SubmitIndex = ++NumPassTimersSubmitted;
+		PassTimer->bInFlight = true;
+	}
+
+	// Histograms of the debug output, outside the timed passes so the governor does not pay for them
+	TShaderMapRef<FFractalMarchHistogramCS> HistogramShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+	if (bMarchHistogram && HistogramShader.IsValid())
+	{
+		FMarchHistogramReadback* FreeSlot = MarchHistogramReadbacks.FindByPredicate([](const FMarchHistogramReadback& Slot) { return !Slot.bInFlight; });
+		if (!FreeSlot && MarchHistogramReadbacks.Num() < MaxMarchHistogramReadbacksInFlight)
+		{
+			FreeSlot = &MarchHistogramReadbacks.AddDefaulted_GetRef();
+			FreeSlot->Readback = MakeUnique<FRHIGPUBufferReadback>(TEXT("FractalMarchHistogramReadback"));
+		}
+
+		// With every slot still waiting on the GPU there is nowhere to read this frame's histogram back to
+		if (FreeSlot)
+		{
+			FRDGBufferRef HistogramBuffer = GraphBuilder.CreateBuffer(
+				FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), FRACTAL_MARCH_HISTOGRAM_SIZE),
+				TEXT("FractalMarchHistogram"));
+			FRDGBufferUAVRef HistogramUAV = GraphBuilder.CreateUAV(HistogramBuffer);
+			AddClearUAVPass(GraphBuilder, HistogramUAV, 0u);
+
+			FFractalMarchHistogramCS::FParameters* HistogramParameters = GraphBuilder.AllocParameters<FFractalMarchHistogramCS::FParameters>();
+			HistogramParameters->InputSize = MarchExtent;
+			HistogramParameters->MarchDebugTexture = MarchDebugTexture;
+			HistogramParameters->HistogramBuffer = HistogramUAV;
+			HistogramParameters->MaxRaySteps = CurrentParams.MaxRaySteps;
+			HistogramParameters->IterationBucketScale = GetIterationBucketScale(CurrentParams.MaxRaySteps, CurrentParams.MaxIterations);
+
+			FComputeShaderUtils::AddPass(
+				GraphBuilder,
+				RDG_EVENT_NAME("FractalMarchHistogram %dx%d", MarchExtent.X, MarchExtent.Y),
+				HistogramShader,
+				HistogramParameters,
+				FComputeShaderUtils::GetGroupCount(MarchExtent, FIntPoint(NUM_THREADS_PerturbationShader_X, NUM_THREADS_PerturbationShader_Y)));
+
+			AddEnqueueCopyPass(GraphBuilder, FreeSlot->Readback.Get(), HistogramBuffer, FRACTAL_MARCH_HISTOGRAM_SIZE * sizeof(uint32));
+			FreeSlot->MaxRaySteps = CurrentParams.MaxRaySteps;
+			FreeSlot->MaxIterations = CurrentParams.MaxIterations;
+			FreeSlot->SubmitIndex = ++NumMarchHistogramsSubmitted;
+			FreeSlot->bInFlight = true;
+		}
+	}
+
+	// This frame's hits become the next frame's history, seen from this frame's camera
+	if (History)
+	{
+		GraphBuilder.QueueTextureExtraction(HistoryOutput, &History->Texture);
+		History->TranslatedWorldToClip = FMatrix44f(View.ViewMatrices.GetTranslatedViewProjectionMatrix());
+		History->PreViewTranslation = FVector3f(View.ViewMatrices.GetPreViewTranslation());
+		History->Extent = MarchExtent;
+		History->Parameters = CurrentParams;
+		History->ConfiguredIterations = ConfiguredIterations;
+	}
+
+	// With every slot still waiting on the GPU this frame's counters are simply dropped
+	{
+		FMarchStatsReadback* FreeSlot = MarchStatsReadbacks.FindByPredicate([](const FMarchStatsReadback& Slot) { return !Slot.bInFlight; });
+		if (!FreeSlot && MarchStatsReadbacks.Num() < MaxMarchStatsReadbacksInFlight)
+		{
+			FreeSlot = &MarchStatsReadbacks.AddDefaulted_GetRef();
+			FreeSlot->Readback = MakeUnique<FRHIGPUBufferReadback>(TEXT("FractalMarchStatsReadback"));
+		}
+
+		if (FreeSlot)
+		{
+			AddEnqueueCopyPass(GraphBuilder, FreeSlot->Readback.Get(), MarchStatsBuffer, FRACTAL_NUM_MARCH_STATS * sizeof(uint32));
+			FreeSlot->SubmitIndex = ++NumMarchStatsSubmitted;
+			FreeSlot->bInFlight = true;
+		}
+	}
+
+	// Pixels outliving a partially streamed orbit look glitched, so reports wait until it is resident
+	if (CVarGlitchReadback.GetValueOnRenderThread() != 0 && PassParameters->NumReferences > 0 && OrbitGpu.IsFullyStreamed())
+	{
+		FGlitchReadback* FreeSlot = GlitchReadbacks.FindByPredicate([](const FGlitchReadback& Slot) { return !Slot.bInFlight; });
+		if (!FreeSlot && GlitchReadbacks.Num() < MaxGlitchReadbacksInFlight)
+		{
+			FreeSlot = &GlitchReadbacks.AddDefaulted_GetRef();
+			FreeSlot->Readback = MakeUnique<FRHIGPUBufferReadback>(TEXT("FractalGlitchReadback"));
+		}
+
+		// With every slot still waiting on the GPU this frame's report is simply dropped
+		if (FreeSlot)
+		{
+			AddEnqueueCopyPass(GraphBuilder, FreeSlot->Readback.Get(), GlitchBuffer, GlitchBufferNumElements * sizeof(uint32));
+			FreeSlot->OrbitVersion = OrbitGpu.Snapshot.IsValid() ? OrbitGpu.Snapshot->OrbitVersion : 0;
+			FreeSlot->NumReferences = PassParameters->NumReferences;
+			FreeSlot->SubmitIndex = ++NumGlitchReadbacksSubmitted;
+			FreeSlot->bInFlight = true;
+		}
+	}
+
 	return FScreenPassTexture(OutputTexture, SceneColor.ViewRect);
 }
 
-FRDGTextureRef FFractalSceneViewExtension::CreateOrbitTexture(
+void FFractalSceneViewExtension::UpdateOrbitGpuResources(FRDGBuilder& GraphBuilder, const TSharedPtr<const FFractalOrbitSnapshot, ESPMode::ThreadSafe>& Snapshot)
+{
+	check(IsInRenderingThread());
+
+	// Steady state only compares generations and, while a stream is incomplete, uploads its next chunks
+	const FOrbitGpuResources& Newest = PendingOrbitGpu.Snapshot.IsValid() ? PendingOrbitGpu : OrbitGpu;
+	const uint64 Generation = Snapshot.IsValid() ? Snapshot->Generation : 0;
+	const uint64 UploadedGeneration = Newest.Snapshot.IsValid() ? Newest.Snapshot->Generation : 0;
+	if (Generation != UploadedGeneration)
+	{
+		// Rows either set already holds are copied on the GPU; only new rows are streamed from the snapshot.
+		// Frames already in flight keep their own references to the buffers this replaces.
+		FOrbitGpuResources Resources = AllocateOrbitGpuResources(GraphBuilder, Snapshot);
+		CopyResidentOrbitRows(GraphBuilder, OrbitGpu, Resources);
+		CopyResidentOrbitRows(GraphBuilder, PendingOrbitGpu, Resources);
+		PendingOrbitGpu = MoveTemp(Resources);
+
+		// Rows of another primary orbit are wrong, and a bound set that is still streaming has nothing to protect, so
+		// those switch at once. Grid and secondary changes stream behind the bound set and take over once resident.
+		const bool bSamePrimary = Snapshot.IsValid() && OrbitGpu.Snapshot.IsValid() && Snapshot->OrbitVersion == OrbitGpu.Snapshot->OrbitVersion;
+		if (!bSamePrimary || !OrbitGpu.IsFullyStreamed())
+		{
+			OrbitGpu = MoveTemp(PendingOrbitGpu);
+			PendingOrbitGpu = FOrbitGpuResources();
+		}
+	}
+
+	if (!PendingOrbitGpu.Snapshot.IsValid())
+	{
+		StreamOrbitChunks(GraphBuilder, OrbitGpu);
+		return;
+	}
+
+	StreamOrbitChunks(GraphBuilder, PendingOrbitGpu);
+	if (PendingOrbitGpu.IsFullyStreamed())
+	{
+		OrbitGpu = MoveTemp(PendingOrbitGpu);
+		PendingOrbitGpu = FOrbitGpuResources();
+	}
+}
+
+FFractalSceneViewExtension::FOrbitGpuResources FFractalSceneViewExtension::AllocateOrbitGpuResources(FRDGBuilder& GraphBuilder, const TSharedPtr<const FFractalOrbitSnapshot, ESPMode::ThreadSafe>& Snapshot)
+{
+	FOrbitGpuResources Resources;
+	Resources.Snapshot = Snapshot;
+
+	const int32 NumReferences = Snapshot.IsValid() ? Snapshot->ReferenceCenters.Num() : 0;
+	const int32 NumPoints = NumReferences > 0 ? (Snapshot->bCompactEncoding ? Snapshot->CompactPositionData.Num() : Snapshot->PositionData.Num()) : 0;
+	if (NumPoints == 0)
+	{
+		return Resources;
+	}
+
+	// Full-size buffers are allocated up front and filled chunk by chunk over the following frames
+	const auto Allocate = [&GraphBuilder](uint32 BytesPerElement, int32 NumElements, const TCHAR* Name)
+	{
+		return GraphBuilder.ConvertToExternalBuffer(GraphBuilder.CreateBuffer(FRDGBufferDesc::CreateStructuredDesc(BytesPerElement, NumElements), Name));
+	};
+
+	if (Snapshot->bCompactEncoding)
+	{
+		Resources.Positions = Allocate(sizeof(FUintVector2), NumPoints, TEXT("CompactOrbitBuffer"));
+		Resources.CompactBlocks = Allocate(sizeof(FVector4f), Snapshot->CompactBlockData.Num(), TEXT("CompactOrbitBlockBuffer"));
+		if (Snapshot->bHasDerivatives && Snapshot->CompactScaleData.Num() == NumPoints)
+		{
+			Resources.Derivatives = Allocate(sizeof(float), NumPoints, TEXT("CompactScaleBuffer"));
+		}
+	}
+	else
+	{
+		Resources.Positions = Allocate(sizeof(FVector3f), NumPoints, TEXT("ReferenceOrbitBuffer"));
+		if (Snapshot->bHasDerivatives && Snapshot->DerivativeData.Num() == NumPoints)
+		{
+			Resources.Derivatives = Allocate(sizeof(FVector3f), NumPoints, TEXT("ReferenceDerivativeBuffer"));
+		}
+	}
+	Resources.NumReferences = NumReferences;
+	Resources.NumPoints = NumPoints;
+	Resources.RowStreamedPoints.SetNumZeroed(NumReferences);
+
+	// The series seeds eps and dr at the skip iteration, so it is only useful with the derivative channel.
+	// It is a few kilobytes per reference and goes up whole; skips past the streamed length are ignored by the shader.
+	uint32 SeriesBytes = 0;
+	if (Snapshot->bHasSeriesApproximation && Resources.Derivatives.IsValid()
+		&& Snapshot->SeriesData.Num() == NumReferences * FOrbitSeriesApproximation::NumRadiusBuckets * FOrbitSeriesApproximation::TexelsPerBucket)
+	{
+		Resources.Series = GraphBuilder.ConvertToExternalBuffer(CreateOrbitBuffer(GraphBuilder, Snapshot->SeriesData, TEXT("SeriesApproximationBuffer")));
+		SeriesBytes = static_cast<uint32>(Snapshot->SeriesData.NumBytes());
+	}
+
+	INC_DWORD_STAT_BY(STAT_FractalOrbitUploadBytes, SeriesBytes);
+	RenderUploadBytes += SeriesBytes;
+	INC_DWORD_STAT(STAT_FractalOrbitUploads);
+
+	UE_LOG(LogFractalViewExtension, Verbose, TEXT("Streaming orbit generation %llu (v%llu): %d references, %d points, %s encoding"),
+		Snapshot->Generation, Snapshot->OrbitVersion, NumReferences, NumPoints, Snapshot->bCompactEncoding ? TEXT("compact") : TEXT("float3"));
+
+	return Resources;
+}
+
+void FFractalSceneViewExtension::CopyResidentOrbitRows(FRDGBuilder& GraphBuilder, const FOrbitGpuResources& Source, FOrbitGpuResources& Target)
+{
+	if (Source.NumStreamedPoints == 0 || Target.NumPoints == 0
+		|| Source.Snapshot->bCompactEncoding != Target.Snapshot->bCompactEncoding
+		|| (Target.Derivatives.IsValid() && !Source.Derivatives.IsValid()))
+	{
+		return;
+	}
+
+	const auto CopyElements = [&GraphBuilder](const TRefCountPtr<FRDGPooledBuffer>& From, const TRefCountPtr<FRDGPooledBuffer>& To, int32 FromElement, int32 ToElement, int32 NumElements)
+	{
+		const uint32 BytesPerElement = To->Desc.BytesPerElement;
+		AddCopyBufferPass(GraphBuilder, GraphBuilder.RegisterExternalBuffer(To), ToElement * BytesPerElement,
+			GraphBuilder.RegisterExternalBuffer(From), FromElement * BytesPerElement, NumElements * BytesPerElement);
+	};
+
+	int32 NumCopiedRows = 0;
+	for (int32 Row = 0; Row < Target.NumReferences; ++Row)
+	{
+		const int32 SourceRow = Source.Snapshot->RowVersions.IndexOfByKey(Target.Snapshot->RowVersions[Row]);
+		if (SourceRow == INDEX_NONE || Source.RowStreamedPoints[SourceRow] <= Target.RowStreamedPoints[Row])
+		{
+			continue;
+		}
+
+		const int32 From = static_cast<int32>(Source.Snapshot->RowOffsets[SourceRow]);
+		const int32 To = static_cast<int32>(Target.Snapshot->RowOffsets[Row]);
+		const int32 Count = Source.RowStreamedPoints[SourceRow];
+		CopyElements(Source.Positions, Target.Positions, From, To, Count);
+		if (Target.Derivatives.IsValid())
+		{
+			CopyElements(Source.Derivatives, Target.Derivatives, From, To, Count);
+		}
+		if (Target.CompactBlocks.IsValid())
+		{
+			// Rows start on block boundaries and stream in whole blocks until their padded end
+			CopyElements(Source.CompactBlocks, Target.CompactBlocks, From / FCompactOrbitEncoding::PointsPerBlock,
+				To / FCompactOrbitEncoding::PointsPerBlock, FMath::DivideAndRoundUp(Count, FCompactOrbitEncoding::PointsPerBlock));
+		}
+
+		Target.NumStreamedPoints += Count - Target.RowStreamedPoints[Row];
+		Target.RowStreamedPoints[Row] = Count;
+		++NumCopiedRows;
+	}
+
+	if (NumCopiedRows > 0)
+	{
+		UE_LOG(LogFractalViewExtension, Verbose, TEXT("Orbit generation %llu: %d of %d rows copied from generation %llu"),
+			Target.Snapshot->Generation, NumCopiedRows, Target.NumReferences, Source.Snapshot->Generation);
+	}
+}
+
+void FFractalSceneViewExtension::StreamOrbitChunks(FRDGBuilder& GraphBuilder, FOrbitGpuResources& Resources)
+{
+	check(IsInRenderingThread());
+
+	if (Resources.IsFullyStreamed())
+	{
+		return;
+	}
+
+	const FFractalOrbitSnapshot& Snapshot = *Resources.Snapshot;
+	const bool bCompact = Snapshot.bCompactEncoding;
+
+	// Compact chunks cover whole blocks so each block header goes up with its points
+	int32 ChunkPoints = FMath::Max(CVarOrbitUploadChunkPoints.GetValueOnRenderThread(), 1);
+	if (bCompact)
+	{
+		ChunkPoints = Align(ChunkPoints, FCompactOrbitEncoding::PointsPerBlock);
+	}
+	const int64 BudgetBytes = FMath::Max<int64>(CVarOrbitUploadBudgetKB.GetValueOnRenderThread(), 0) * 1024;
+
+	// Rows stream in order, skipping those already resident. At least one chunk per frame, so a tiny budget still finishes.
+	int64 UploadBytes = 0;
+	int32 NumChunks = 0;
+	int32 Row = 0;
+	while (!Resources.IsFullyStreamed() && (NumChunks == 0 || UploadBytes < BudgetBytes))
+	{
+		const int32 RowElements = Resources.GetRowNumElements(Row);
+		if (Resources.RowStreamedPoints[Row] >= RowElements)
+		{
+			++Row;
+			continue;
+		}
+
+		const int32 First = static_cast<int32>(Snapshot.RowOffsets[Row]) + Resources.RowStreamedPoints[Row];
+		const int32 Count = FMath::Min(ChunkPoints, RowElements - Resources.RowStreamedPoints[Row]);
+
+		if (bCompact)
+		{
+			UploadBytes += AddOrbitChunkUploadPass(GraphBuilder, Resources.Positions, Snapshot.CompactPositionData, First, Count, Resources.Snapshot);
+			UploadBytes += AddOrbitChunkUploadPass(GraphBuilder, Resources.CompactBlocks, Snapshot.CompactBlockData,
+				First / FCompactOrbitEncoding::PointsPerBlock, FMath::DivideAndRoundUp(Count, FCompactOrbitEncoding::PointsPerBlock), Resources.Snapshot);
+			if (Resources.Derivatives.IsValid())
+			{
+				UploadBytes += AddOrbitChunkUploadPass(GraphBuilder, Resources.Derivatives, Snapshot.CompactScaleData, First, Count, Resources.Snapshot);
+			}
+		}
+		else
+		{
+			UploadBytes += AddOrbitChunkUploadPass(GraphBuilder, Resources.Positions, Snapshot.PositionData, First, Count, Resources.Snapshot);
+			if (Resources.Derivatives.IsValid())
+			{
+				UploadBytes += AddOrbitChunkUploadPass(GraphBuilder, Resources.Derivatives, Snapshot.DerivativeData, First, Count, Resources.Snapshot);
+			}
+		}
+
+		Resources.RowStreamedPoints[Row] += Count;
+		Resources.NumStreamedPoints += Count;
+		++NumChunks;
+	}
+
+	INC_DWORD_STAT_BY(STAT_FractalOrbitUploadBytes, static_cast<uint32>(UploadBytes));
+	RenderUploadBytes += static_cast<uint32>(UploadBytes);
+	INC_DWORD_STAT_BY(STAT_FractalOrbitUploadChunks, NumChunks);
+
+	if (Resources.IsFullyStreamed())
+	{
+		UE_LOG(LogFractalViewExtension, Verbose, TEXT("Orbit generation %llu fully resident: %d points"), Snapshot.Generation, Resources.NumPoints);
+	}
+}
+
+template<typename ElementType>
+int64 FFractalSceneViewExtension::AddOrbitChunkUploadPass(
 	FRDGBuilder& GraphBuilder,
-	const TArray<FVector4f>& OrbitData)
+	const TRefCountPtr<FRDGPooledBuffer>& PooledBuffer,
+	const TArray<ElementType>& Data,
+	int32 FirstElement,
+	int32 NumElements,
+	const TSharedPtr<const FFractalOrbitSnapshot, ESPMode::ThreadSafe>& Owner)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FFractalSceneViewExtension::CreateOrbitTexture);
-	
-	if (OrbitData.Num() == 0)
+	if (NumElements <= 0)
 	{
-		UE_LOG(LogFractalViewExtension, Warning, TEXT("CreateOrbitTexture: Empty orbit data"));
-		return nullptr;
+		return 0;
 	}
-	
-	const int32 OrbitLength = OrbitData.Num();
-	
-	// Create 1D texture (Width = OrbitLength, Height = 1)
-	// Format: PF_A32B32G32R32F (128-bit per texel, RGBA float)
-	FRDGTextureDesc OrbitDesc = FRDGTextureDesc::Create2D(
-		FIntPoint(OrbitLength, 1),
-		PF_A32B32G32R32F,
-		FClearValueBinding::Black,
-		TexCreate_ShaderResource
-	);
-	
-	FRDGTextureRef OrbitTexture = GraphBuilder.CreateTexture(OrbitDesc, TEXT("ReferenceOrbitTexture"));
-	
-	// Upload orbit data using an RDG copy pass and render-graph managed backing storage
-	FUploadOrbitDataParameters* UploadParams = GraphBuilder.AllocParameters<FUploadOrbitDataParameters>();
-	UploadParams->OrbitTexture = OrbitTexture;
-	
-	const int32 DataSizeBytes = OrbitLength * sizeof(FVector4f);
-	const uint32 RowPitchBytes = static_cast<uint32>(OrbitLength * sizeof(FVector4f));
+	check(FirstElement >= 0 && FirstElement + NumElements <= Data.Num());
 
-	FRDGUploadData<FVector4f> UploadData(GraphBuilder, OrbitLength);
-	FMemory::Memcpy(UploadData.GetData(), OrbitData.GetData(), DataSizeBytes);
+	FRDGBufferRef Buffer = GraphBuilder.RegisterExternalBuffer(PooledBuffer);
+	FUploadOrbitChunkParameters* UploadParams = GraphBuilder.AllocParameters<FUploadOrbitChunkParameters>();
+	UploadParams->OrbitBuffer = Buffer;
 
-	const uint8* UploadDataPtr = reinterpret_cast<const uint8*>(UploadData.GetData());
-	
+	const uint32 OffsetBytes = static_cast<uint32>(FirstElement * sizeof(ElementType));
+	const uint32 SizeBytes = static_cast<uint32>(NumElements * sizeof(ElementType));
+	const uint8* Source = reinterpret_cast<const uint8*>(Data.GetData()) + OffsetBytes;
+
+	// The snapshot owns the source data; holding it keeps the pointer valid even if a newer one replaces it first
 	GraphBuilder.AddPass(
-		RDG_EVENT_NAME("UploadOrbitData"),
+		RDG_EVENT_NAME("UploadOrbitChunk %u bytes", SizeBytes),
 		UploadParams,
 		ERDGPassFlags::Copy | ERDGPassFlags::NeverCull,
-		[OrbitTexture, UploadDataPtr, OrbitLength, RowPitchBytes](FRHICommandList& RHICmdList)
-		{
-			// Get the RHI texture
-			FRHITexture* TextureRHI = OrbitTexture->GetRHI();
-			
-			// Define the region to update
-			FUpdateTextureRegion2D Region(0, 0, 0, 0, OrbitLength, 1);
-			
-			// Update texture with orbit data
-			RHICmdList.UpdateTexture2D(
-				TextureRHI,
-				0, // Mip level
-				Region,
-				RowPitchBytes,
-				UploadDataPtr
-			);
+		[Buffer, Source, OffsetBytes, SizeBytes, Owner](FRHICommandListImmediate& RHICmdList)
+		{
+			void* Destination = RHICmdList.LockBuffer(Buffer->GetRHI(), OffsetBytes, SizeBytes, RLM_WriteOnly);
+			FMemory::Memcpy(Destination, Source, SizeBytes);
+			RHICmdList.UnlockBuffer(Buffer->GetRHI());
+		});
+
+	return SizeBytes;
+}
+
+void FFractalSceneViewExtension::PollGlitchReadbacks()
+{
+	check(IsInRenderingThread());
+
+	FFractalGlitchReport Report;
+	const bool bHasNewReport = DecodeNewestReadback(GlitchReadbacks, GlitchBufferNumElements * sizeof(uint32),
+		[&Report](const FGlitchReadback& Slot, const uint32* Data)
+		{
+			Report.OrbitVersion = Slot.OrbitVersion;
+			Report.NumReferences = Slot.NumReferences;
+			Report.NumGlitchedPixels = Data[0];
+
+			const int32 NumSamples = FMath::Min<uint32>(Data[0], FRACTAL_MAX_GLITCH_SAMPLES);
+			Report.Samples.SetNumUninitialized(NumSamples);
+			for (int32 Index = 0; Index < NumSamples; ++Index)
+			{
+				const uint32* Sample = Data + 1 + Index * 3;
+				Report.Samples[Index] = FVector3f(
+					FMath::AsFloat(Sample[0]),
+					FMath::AsFloat(Sample[1]),
+					FMath::AsFloat(Sample[2]));
+			}
+		});
+
+	if (bHasNewReport)
+	{
+		FCountedScopeLock Lock(GlitchMutex, RenderLockWaitSeconds);
+		PendingGlitchReport = MoveTemp(Report);
+		bHasPendingGlitchReport = true;
+	}
+}
+
+void FFractalSceneViewExtension::PollMarchStatsReadbacks()
+{
+	check(IsInRenderingThread());
+
+	FFractalMarchStats Stats;
+	const bool bHasNewStats = DecodeNewestReadback(MarchStatsReadbacks, FRACTAL_NUM_MARCH_STATS * sizeof(uint32),
+		[&Stats](const FMarchStatsReadback&, const uint32* Data)
+		{
+			// MARCH_STAT_* order, step sums as (low, high) halves
+			Stats.NumPixels = Data[0];
+			Stats.MarchSteps = uint64(Data[1]) | (uint64(Data[2]) << 32);
+			Stats.ConeStepsSaved = uint64(Data[3]) | (uint64(Data[4]) << 32);
+			Stats.ConePrepassSteps = Data[5];
+			Stats.NumReprojectedPixels = Data[6];
+		});
+
+	if (!bHasNewStats)
+	{
+		return;
+	}
+
+	SET_FLOAT_STAT(STAT_FractalMarchStepsPerPixel, Stats.GetStepsPerPixel());
+	SET_FLOAT_STAT(STAT_FractalConeStepsSavedPerPixel, Stats.GetConeStepsSavedPerPixel());
+	SET_DWORD_STAT(STAT_FractalConePrepassSteps, Stats.ConePrepassSteps);
+	SET_DWORD_STAT(STAT_FractalReprojectedPixels, Stats.NumReprojectedPixels);
+
+	FCountedScopeLock Lock(MarchStatsMutex, RenderLockWaitSeconds);
+	LatestMarchStats = Stats;
+	bHasMarchStats = true;
+}
+
+void FFractalSceneViewExtension::PollMarchHistogramReadbacks()
+{
+	check(IsInRenderingThread());
+
+	FFractalMarchHistogram Histogram;
+	const bool bHasNewHistogram = DecodeNewestReadback(MarchHistogramReadbacks, FRACTAL_MARCH_HISTOGRAM_SIZE * sizeof(uint32),
+		[&Histogram](const FMarchHistogramReadback& Slot, const uint32* Data)
+		{
+			Histogram = DecodeMarchHistogram(Data, Slot.MaxRaySteps, Slot.MaxIterations);
+		});
+
+	if (!bHasNewHistogram)
+	{
+		return;
+	}
+
+	SET_DWORD_STAT(STAT_FractalHitPixels, Histogram.NumHits);
+	SET_DWORD_STAT(STAT_FractalDistanceMissPixels, Histogram.NumDistanceMisses);
+	SET_DWORD_STAT(STAT_FractalStepLimitedPixels, Histogram.NumStepLimited);
+	SET_FLOAT_STAT(STAT_FractalIterationsPerPixel, Histogram.GetIterationsPerPixel());
+	SET_FLOAT_STAT(STAT_FractalStepsP50, Histogram.GetStepPercentile(0.5f));
+	SET_FLOAT_STAT(STAT_FractalStepsP95, Histogram.GetStepPercentile(0.95f));
+	SET_FLOAT_STAT(STAT_FractalIterationsP50, Histogram.GetIterationPercentile(0.5f));
+	SET_FLOAT_STAT(STAT_FractalIterationsP95, Histogram.GetIterationPercentile(0.95f));
+
+	UE_LOG(LogFractalViewExtension, VeryVerbose, TEXT("March histogram: %u pixels, %u hits, %u distance misses, %u step-limited, %.1f steps and %.1f DE iterations per pixel"),
+		Histogram.NumPixels, Histogram.NumHits, Histogram.NumDistanceMisses, Histogram.NumStepLimited,
+		Histogram.GetStepsPerPixel(), Histogram.GetIterationsPerPixel());
+
+	FCountedScopeLock Lock(MarchStatsMutex, RenderLockWaitSeconds);
+	LatestMarchHistogram = MoveTemp(Histogram);
+	bHasMarchHistogram = true;
+}
+
+void FFractalSceneViewExtension::PollPassTimers()
+{
+	check(IsInRenderingThread());
+
+	// Slots are reused out of order, so the newest finished pair is picked by submission index
+	uint64 NewestIndex = 0;
+	float NewestMs = 0.0f;
+	for (FPassTimer& Timer : PassTimers)
+	{
+		uint64 BeginMicroseconds = 0;
+		uint64 EndMicroseconds = 0;
+		if (!Timer.bInFlight
+			|| !RHIGetRenderQueryResult(Timer.BeginQuery.GetQuery(), BeginMicroseconds, false)
+			|| !RHIGetRenderQueryResult(Timer.EndQuery.GetQuery(), EndMicroseconds, false))
+		{
+			continue;
 		}
+
+		Timer.bInFlight = false;
+		if (EndMicroseconds >= BeginMicroseconds && Timer.SubmitIndex > NewestIndex)
+		{
+			NewestIndex = Timer.SubmitIndex;
+			NewestMs = (EndMicroseconds - BeginMicroseconds) / 1000.0f;
+		}
+	}
+
+	if (NewestIndex == 0)
+	{
+		return;
+	}
+
+	SET_FLOAT_STAT(STAT_FractalGpuTimeMs, NewestMs);
+	TRACE_COUNTER_SET(FractalGpuTimeMs, NewestMs);
+	LatestGpuMs = NewestMs;
+
+	FCountedScopeLock Lock(GpuTimeMutex, RenderLockWaitSeconds);
+	PendingGpuTimeMs = NewestMs;
+	bHasPendingGpuTime = true;
+}
+
+FRDGBufferSRVRef FFractalSceneViewExtension::CreateDummyOrbitBuffer(FRDGBuilder& GraphBuilder, uint32 BytesPerElement, const TCHAR* Name)
+{
+	static const FVector4f Zero(0.0f, 0.0f, 0.0f, 0.0f);
+	check(BytesPerElement <= sizeof(Zero));
+
+	FRDGBufferRef DummyBuffer = CreateStructuredBuffer(GraphBuilder, Name, BytesPerElement, 1, &Zero, BytesPerElement);
+	return GraphBuilder.CreateSRV(DummyBuffer);
+}
+
+template<typename ElementType>
+FRDGBufferRef FFractalSceneViewExtension::CreateOrbitBuffer(
+	FRDGBuilder& GraphBuilder,
+	const TArray<ElementType>& OrbitData,
+	const TCHAR* Name)
+{
+	FRACTAL_TRACE_SCOPE(FFractalSceneViewExtension::CreateOrbitBuffer);
+
+	check(OrbitData.Num() > 0);
+
+	// Structured buffers are bounded by memory rather than the RHI's texture width, so orbits of
+	// millions of points bind as-is. The data is copied into RDG-owned storage because a later view
+	// in the same graph may swap in a newer snapshot and release this one before the upload runs.
+	FRDGBufferRef OrbitBuffer = CreateStructuredBuffer(
+		GraphBuilder,
+		Name,
+		sizeof(ElementType),
+		OrbitData.Num(),
+		OrbitData.GetData(),
+		OrbitData.NumBytes());
+
+	UE_LOG(LogFractalViewExtension, VeryVerbose,
+		TEXT("Created orbit buffer %s: %d elements of %d bytes, %.2f KB"),
+		Name, OrbitData.Num(), static_cast<int32>(sizeof(ElementType)), OrbitData.NumBytes() / 1024.0f
 	);
-	
-	UE_LOG(LogFractalViewExtension, VeryVerbose, 
-		TEXT("Created orbit texture: %dx%d, %d points, %.2f KB"),
-		OrbitLength, 1, OrbitLength, DataSizeBytes / 1024.0f
-	);
-	
-	return OrbitTexture;
+
+	return OrbitBuffer;
 }
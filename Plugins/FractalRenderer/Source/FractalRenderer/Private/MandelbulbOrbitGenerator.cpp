@@ -1,8 +1,720 @@
 #include "MandelbulbOrbitGenerator.h"
+#include "MandelbulbMath.h"
+#include "DoubleDouble.h"
 #include "Misc/ScopeLock.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Async/ParallelFor.h"
+#include "FractalStats.h"
+#include "FractalBenchmarkArgs.h"
+#include <atomic>
 
 DEFINE_LOG_CATEGORY_STATIC(LogMandelbulbOrbit, Log, All);
 
+DECLARE_CYCLE_STAT(TEXT("Orbit Generation"), STAT_FractalOrbitGeneration, STATGROUP_Fractal);
+DECLARE_CYCLE_STAT(TEXT("Orbit Series Approximation"), STAT_FractalSeriesApproximation, STATGROUP_Fractal);
+DECLARE_CYCLE_STAT(TEXT("Reference Center Search"), STAT_FractalReferenceSearch, STATGROUP_Fractal);
+
+namespace
+{
+	// How often (in iterations) background generation polls its cancellation predicate
+	constexpr int32 CancelPollInterval = 256;
+
+	/** Split a real into its double-rounded value and the remaining low-order part. */
+	FORCEINLINE double LowPart(double) { return 0.0; }
+	FORCEINLINE double LowPart(const FDoubleDouble& V) { return V.Lo; }
+
+	/** Rebuild a real from a stored double and its low-order part. */
+	template <typename RealType>
+	FORCEINLINE RealType JoinReal(double Hi, double Lo)
+	{
+		if constexpr (std::is_same_v<RealType, FDoubleDouble>)
+		{
+			return FDoubleDouble(Hi, Lo);
+		}
+		else
+		{
+			return Hi;
+		}
+	}
+
+	template <typename RealType>
+	FORCEINLINE MandelbulbMath::TVec3<RealType> JoinVector(const FVector3d& Hi, const FVector3d& Lo)
+	{
+		return MandelbulbMath::TVec3<RealType>(JoinReal<RealType>(Hi.X, Lo.X), JoinReal<RealType>(Hi.Y, Lo.Y), JoinReal<RealType>(Hi.Z, Lo.Z));
+	}
+
+	template <typename RealType>
+	FORCEINLINE FVector3d LowParts(const MandelbulbMath::TVec3<RealType>& V)
+	{
+		return FVector3d(LowPart(V.X), LowPart(V.Y), LowPart(V.Z));
+	}
+
+	/**
+	 * Core orbit loop, instantiated per real type and per polynomial power (P > 0) plus the trig
+	 * fallback (P == 0) so both precision and power map are resolved at compile time.
+	 * The recurrence runs in RealType; stored points are rounded to double.
+	 *
+	 * An empty orbit starts from z_0 = 0. An orbit that already has computed points resumes from
+	 * the last one using its ResumeState, so only iterations past GetComputedLength() are evaluated.
+	 * Returns false (and restores the orbit's computed length) if cancelled.
+	 */
+	template <typename RealType, int32 P>
+	bool IterateOrbit(
+		FReferenceOrbit& Result,
+		const MandelbulbMath::TVec3<RealType>& C,
+		int32 MaxIterations,
+		const TFunction<bool()>& ShouldCancel)
+	{
+		using FVec = MandelbulbMath::TVec3<RealType>;
+
+		// Unqualified so extended types pick up their own overload by argument-dependent lookup
+		using MandelbulbMath::ToDouble;
+
+		const double Power = Result.Power;
+		const double BailoutRadiusSq = Result.BailoutRadius * Result.BailoutRadius;
+		const int32 StartLength = Result.GetComputedLength();
+		check(StartLength == 0 || Result.CanResume());
+
+		// Running scalar derivative of the reference orbit, matching the shader's DE recurrence
+		double RunningDerivative = 1.0;
+
+		// Fill in the derivative channel of z_n once its radius is known, then advance dr
+		const auto FinalizeDerivative = [&](int32 Index, double RadiusSq)
+		{
+			const double Radius = FMath::Sqrt(RadiusSq);
+			double Scale;
+			if constexpr (P > 0)
+			{
+				Scale = P * MandelbulbMath::IntPow<P - 1>(Radius);
+			}
+			else
+			{
+				Scale = Power * FMath::Pow(Radius, Power - 1.0);
+			}
+
+			Result.SetDerivative(Index, RunningDerivative, Scale, Radius);
+			RunningDerivative = Scale * RunningDerivative + 1.0;
+		};
+
+		FVec Z;
+		int32 FirstIteration = 0;
+		if (StartLength == 0)
+		{
+			// Initial point: z_0 = 0
+			Result.AddPoint(FVector3d::ZeroVector);
+			Result.ResumeState.CenterLow = LowParts(C);
+		}
+		else
+		{
+			// Continue from the last computed point; its derivative is re-finalized to the same value
+			FirstIteration = StartLength - 1;
+			Z = JoinVector<RealType>(Result.GetPosition(FirstIteration), Result.ResumeState.TailLow);
+			RunningDerivative = Result.ResumeState.RunningDerivative;
+		}
+
+		// Iterate Mandelbulb formula: z_{n+1} = g_p(z_n) + C_0
+		bool bEscaped = false;
+		for (int32 Iteration = FirstIteration; Iteration < MaxIterations; ++Iteration)
+		{
+			// Newer parameters may have superseded this orbit while it was being generated
+			if (((Iteration - FirstIteration) % CancelPollInterval) == 0 && ShouldCancel && ShouldCancel())
+			{
+				UE_LOG(LogMandelbulbOrbit, Verbose, TEXT("Orbit generation cancelled at iteration %d"), Iteration);
+				Result.DiscardFrom(StartLength);
+				return false;
+			}
+
+			const double RadiusSq = ToDouble(Z.SquaredLength());
+			FinalizeDerivative(Iteration, RadiusSq);
+
+			// Check bailout condition on |z|^2 to avoid a square root
+			if (RadiusSq > BailoutRadiusSq)
+			{
+				Result.MarkEscaped(Iteration);
+				bEscaped = true;
+				break;
+			}
+
+			Z = MandelbulbMath::PowerMap<P>(Z, Power) + C;
+			Result.AddPoint(Z.ToVector3d());
+		}
+
+		// The final point was never visited by the loop body when the iteration limit was reached
+		if (!bEscaped)
+		{
+			Result.ResumeState.TailLow = LowParts(Z);
+			Result.ResumeState.RunningDerivative = RunningDerivative;
+			FinalizeDerivative(Result.GetComputedLength() - 1, ToDouble(Z.SquaredLength()));
+		}
+
+		Result.bHasDerivatives = true;
+		return true;
+	}
+
+	/** Probe directions for the series: the coordinate axes (their first-order terms are the columns of A_n) and the cube diagonals. */
+	constexpr int32 NumSeriesProbes = 7;
+
+	/**
+	 * Builds the series approximation table of an orbit for integer power P.
+	 *
+	 * eps_n along each probe direction u is carried as a second-order jet in t = |delta|, so
+	 * D1 = A_n * u and D2 is the quadratic term. The jets ride on the stored reference points rather
+	 * than re-iterating z_n, so the coefficients follow the same orbit the shader perturbs around.
+	 * Bucket k stays open while |delta| = 2^-k keeps the second-order term within Tolerance of the
+	 * first on every probe, eps stays well inside the expansion radius |Z_n|, and |Z_n| + |delta| * |A_n|
+	 * stays inside the bailout radius.
+	 */
+	template <int32 P>
+	bool BuildSeriesApproximation(
+		const FReferenceOrbit& Orbit,
+		double Tolerance,
+		const TFunction<bool()>& ShouldCancel,
+		FOrbitSeriesApproximation& OutTable)
+	{
+		using MandelbulbMath::FJet2;
+
+		const double Diagonal = 1.0 / FMath::Sqrt(3.0);
+		const FVector3d Probes[NumSeriesProbes] = {
+			FVector3d(1.0, 0.0, 0.0),
+			FVector3d(0.0, 1.0, 0.0),
+			FVector3d(0.0, 0.0, 1.0),
+			FVector3d(Diagonal, Diagonal, Diagonal),
+			FVector3d(Diagonal, Diagonal, -Diagonal),
+			FVector3d(Diagonal, -Diagonal, Diagonal),
+			FVector3d(-Diagonal, Diagonal, Diagonal)
+		};
+
+		// z_0 = 0 for every C, so eps_0 and all its coefficients vanish
+		FVector3d First[NumSeriesProbes];
+		FVector3d Second[NumSeriesProbes];
+		for (int32 Probe = 0; Probe < NumSeriesProbes; ++Probe)
+		{
+			First[Probe] = FVector3d::ZeroVector;
+			Second[Probe] = FVector3d::ZeroVector;
+		}
+		FVector3d Columns[3] = { FVector3d::ZeroVector, FVector3d::ZeroVector, FVector3d::ZeroVector };
+
+		OutTable.GpuData.SetNumZeroed(FOrbitSeriesApproximation::NumRadiusBuckets * FOrbitSeriesApproximation::TexelsPerBucket);
+
+		const int32 Length = Orbit.GetLength();
+		const double BailoutRadius = Orbit.BailoutRadius;
+
+		// Terms beyond second order scale with the square of this fraction, matching the ratio tolerance
+		const double ConvergenceFraction = FMath::Sqrt(Tolerance);
+
+		// Validity only shrinks with the radius, so buckets close in order; those below NextBucket are final
+		int32 NextBucket = 0;
+		int32 Iteration = 1;
+		for (; Iteration < Length && NextBucket < FOrbitSeriesApproximation::NumRadiusBuckets; ++Iteration)
+		{
+			if ((Iteration % CancelPollInterval) == 0 && ShouldCancel && ShouldCancel())
+			{
+				return false;
+			}
+
+			// The power map is not differentiable at the origin; nothing past a revisit of it can be skipped
+			const FVector3d Previous = Orbit.GetPosition(Iteration - 1);
+			if (Iteration > 1 && Previous.SizeSquared() <= FMath::Square(MandelbulbMath::AngleEpsilon))
+			{
+				break;
+			}
+
+			// eps_n = g_p(Z_{n-1} + eps_{n-1}) - g_p(Z_{n-1}) + delta, truncated after t^2
+			double MaxRatio = 0.0;
+			for (int32 Probe = 0; Probe < NumSeriesProbes; ++Probe)
+			{
+				const FJet2 X(Previous.X, First[Probe].X, Second[Probe].X);
+				const FJet2 Y(Previous.Y, First[Probe].Y, Second[Probe].Y);
+				const FJet2 Z(Previous.Z, First[Probe].Z, Second[Probe].Z);
+				FJet2 OutX, OutY, OutZ;
+				MandelbulbMath::PolynomialPowerMap<P>(X, Y, Z, OutX, OutY, OutZ);
+
+				First[Probe] = FVector3d(OutX.D1, OutY.D1, OutZ.D1) + Probes[Probe];
+				Second[Probe] = FVector3d(OutX.D2, OutY.D2, OutZ.D2);
+
+				const double FirstLength = First[Probe].Length();
+				const double SecondLength = Second[Probe].Length();
+				if (SecondLength > 0.0)
+				{
+					MaxRatio = FMath::Max(MaxRatio, FirstLength > 0.0 ? SecondLength / FirstLength : TNumericLimits<double>::Max());
+				}
+			}
+
+			// Frobenius norms bound |A_n * delta| / |delta| from above
+			const double JacobianNorm = FMath::Sqrt(First[0].SizeSquared() + First[1].SizeSquared() + First[2].SizeSquared());
+			const double PreviousJacobianNorm = FMath::Sqrt(Columns[0].SizeSquared() + Columns[1].SizeSquared() + Columns[2].SizeSquared());
+			const double ReferenceRadius = Orbit.GetPosition(Iteration).Length();
+
+			// g_p expands around Z_{n-1} only within |Z_{n-1}|; derivatives there can be too small for the
+			// ratio test to notice higher-order terms, so eps_{n-1} is also kept well inside that radius
+			const double ConvergenceRadius = ConvergenceFraction * Previous.Length();
+
+			for (; NextBucket < FOrbitSeriesApproximation::NumRadiusBuckets; ++NextBucket)
+			{
+				const double Radius = FMath::Exp2(-static_cast<double>(NextBucket));
+				if (Radius * MaxRatio <= Tolerance
+					&& Radius * PreviousJacobianNorm <= ConvergenceRadius
+					&& ReferenceRadius + Radius * JacobianNorm <= BailoutRadius)
+				{
+					break;
+				}
+
+				// Still holds A_{n-1}, the last iteration this bucket was valid at
+				OutTable.SetBucket(NextBucket, Iteration - 1, Columns, Orbit.GetDerivative(Iteration - 1).X);
+			}
+
+			Columns[0] = First[0];
+			Columns[1] = First[1];
+			Columns[2] = First[2];
+		}
+
+		// Buckets still open are valid through the last iteration examined
+		for (; NextBucket < FOrbitSeriesApproximation::NumRadiusBuckets; ++NextBucket)
+		{
+			OutTable.SetBucket(NextBucket, Iteration - 1, Columns, Orbit.GetDerivative(Iteration - 1).X);
+		}
+
+		return true;
+	}
+
+	// A candidate orbit returning this close (squared) to its last checkpoint is taken to have entered a cycle
+	constexpr double PeriodToleranceSq = 1e-24;
+
+	// Candidates per ParallelFor task in the reference center search (a multiple of the SIMD lane count)
+	constexpr int32 CandidatesPerSearchBatch = 32;
+	static_assert(CandidatesPerSearchBatch % MandelbulbMath::FDouble4::NumLanes == 0, "Search batches must hold whole SIMD registers");
+
+	struct FCandidateOrbitResult
+	{
+		int32 EscapeIteration = -1;
+		int32 Period = 0;
+	};
+
+	/** Candidates of the reference center search in evaluation order: ViewCenter, then the grid without its middle. */
+	template <typename FunctorType>
+	void ForEachSearchCandidate(const FVector3d& ViewCenter, double SearchRadius, int32 CandidatesPerAxis, FunctorType&& Visit)
+	{
+		// The middle of an odd grid is the view center again and is skipped
+		Visit(ViewCenter);
+		const int32 PerAxis = FMath::Max(CandidatesPerAxis, 1);
+		const double Step = PerAxis > 1 ? 2.0 * SearchRadius / (PerAxis - 1) : 0.0;
+		for (int32 K = 0; K < PerAxis; ++K)
+		{
+			for (int32 J = 0; J < PerAxis; ++J)
+			{
+				for (int32 I = 0; I < PerAxis; ++I)
+				{
+					if (2 * I == PerAxis - 1 && 2 * J == PerAxis - 1 && 2 * K == PerAxis - 1)
+					{
+						continue;
+					}
+					Visit(ViewCenter + FVector3d(I * Step - SearchRadius, J * Step - SearchRadius, K * Step - SearchRadius));
+				}
+			}
+		}
+	}
+
+	/**
+	 * Index of the winning candidate: longest survival first; among survivors a detected cycle (certainly
+	 * interior) beats merely bounded; then the one nearest the view center, DistanceSq(Index).
+	 */
+	template <typename FunctorType>
+	int32 PickSearchCandidate(TConstArrayView<FCandidateOrbitResult> Results, int32 MaxIterations, FunctorType&& DistanceSq)
+	{
+		const auto Score = [MaxIterations](const FCandidateOrbitResult& Candidate)
+		{
+			return Candidate.EscapeIteration < 0 ? MaxIterations + 1 : Candidate.EscapeIteration;
+		};
+
+		int32 Best = 0;
+		for (int32 Index = 1; Index < Results.Num(); ++Index)
+		{
+			const FCandidateOrbitResult& Candidate = Results[Index];
+			const FCandidateOrbitResult& Current = Results[Best];
+			if (Score(Candidate) != Score(Current))
+			{
+				Best = Score(Candidate) > Score(Current) ? Index : Best;
+			}
+			else if ((Candidate.Period > 0) != (Current.Period > 0))
+			{
+				Best = Candidate.Period > 0 ? Index : Best;
+			}
+			else if (DistanceSq(Index) < DistanceSq(Best))
+			{
+				Best = Index;
+			}
+		}
+		return Best;
+	}
+
+	/** What IterateCandidateLanes reports for a candidate, read off its fully generated scalar orbit. */
+	FCandidateOrbitResult GetCandidateResult(const FReferenceOrbit& Orbit, int32 MaxIterations)
+	{
+		FCandidateOrbitResult Result;
+		FVector3d Checkpoint = FVector3d::ZeroVector;
+		int32 CheckpointIteration = 0;
+		int32 NextCheckpoint = 1;
+		for (int32 Iteration = 0; Iteration < FMath::Min(Orbit.GetLength(), MaxIterations); ++Iteration)
+		{
+			const FVector3d Z = Orbit.GetPosition(Iteration);
+			if (Orbit.IsEscaped(Iteration))
+			{
+				Result.EscapeIteration = Iteration;
+				break;
+			}
+			if (Iteration > 0 && FVector3d::DistSquared(Z, Checkpoint) < PeriodToleranceSq)
+			{
+				Result.Period = Iteration - CheckpointIteration;
+				break;
+			}
+			if (Iteration == NextCheckpoint)
+			{
+				Checkpoint = Z;
+				CheckpointIteration = Iteration;
+				NextCheckpoint *= 2;
+			}
+		}
+		return Result;
+	}
+
+	/**
+	 * Iterates FDouble4::NumLanes candidate centers in lockstep until each escapes, is found periodic or
+	 * reaches MaxIterations. Periodicity is detected Brent-style against a checkpoint refreshed at every
+	 * power-of-two iteration. Finished lanes are frozen so they never overflow. Returns false if cancelled.
+	 */
+	template <int32 P>
+	bool IterateCandidateLanes(
+		const double* CenterX,
+		const double* CenterY,
+		const double* CenterZ,
+		int32 MaxIterations,
+		double BailoutRadius,
+		const TFunction<bool()>& ShouldCancel,
+		FCandidateOrbitResult* OutResults)
+	{
+		using MandelbulbMath::FDouble4;
+		constexpr int32 NumLanes = FDouble4::NumLanes;
+
+		const FDouble4 CX = FDouble4::Load(CenterX);
+		const FDouble4 CY = FDouble4::Load(CenterY);
+		const FDouble4 CZ = FDouble4::Load(CenterZ);
+		const FDouble4 BailoutRadiusSq(BailoutRadius * BailoutRadius);
+		const FDouble4 PeriodTolerance(PeriodToleranceSq);
+
+		// z_0 = 0, which is also the first checkpoint
+		FDouble4 X, Y, Z;
+		FDouble4 CheckX, CheckY, CheckZ;
+		int32 CheckpointIteration = 0;
+		int32 NextCheckpoint = 1;
+
+		double LaneActive[NumLanes] = { 1.0, 1.0, 1.0, 1.0 };
+		FDouble4 ActiveMask = MandelbulbMath::CompareGT(FDouble4::Load(LaneActive), FDouble4(0.0));
+		int32 ActiveBits = (1 << NumLanes) - 1;
+
+		for (int32 Iteration = 0; Iteration < MaxIterations; ++Iteration)
+		{
+			if ((Iteration % CancelPollInterval) == 0 && ShouldCancel && ShouldCancel())
+			{
+				return false;
+			}
+
+			const int32 EscapedBits = MandelbulbMath::MaskBits(MandelbulbMath::CompareGT(X * X + Y * Y + Z * Z, BailoutRadiusSq)) & ActiveBits;
+			const FDouble4 DX = X - CheckX;
+			const FDouble4 DY = Y - CheckY;
+			const FDouble4 DZ = Z - CheckZ;
+			const int32 PeriodicBits = Iteration > 0
+				? MandelbulbMath::MaskBits(MandelbulbMath::CompareGT(PeriodTolerance, DX * DX + DY * DY + DZ * DZ)) & ActiveBits & ~EscapedBits
+				: 0;
+
+			if ((EscapedBits | PeriodicBits) != 0)
+			{
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+				{
+					if (EscapedBits & (1 << Lane))
+					{
+						OutResults[Lane].EscapeIteration = Iteration;
+						LaneActive[Lane] = 0.0;
+					}
+					else if (PeriodicBits & (1 << Lane))
+					{
+						OutResults[Lane].Period = Iteration - CheckpointIteration;
+						LaneActive[Lane] = 0.0;
+					}
+				}
+
+				ActiveBits &= ~(EscapedBits | PeriodicBits);
+				if (ActiveBits == 0)
+				{
+					break;
+				}
+				ActiveMask = MandelbulbMath::CompareGT(FDouble4::Load(LaneActive), FDouble4(0.0));
+			}
+
+			if (Iteration == NextCheckpoint)
+			{
+				CheckX = X;
+				CheckY = Y;
+				CheckZ = Z;
+				CheckpointIteration = Iteration;
+				NextCheckpoint *= 2;
+			}
+
+			FDouble4 NewX, NewY, NewZ;
+			MandelbulbMath::PolynomialPowerMap<P>(X, Y, Z, NewX, NewY, NewZ);
+			X = MandelbulbMath::Select(ActiveMask, NewX + CX, X);
+			Y = MandelbulbMath::Select(ActiveMask, NewY + CY, Y);
+			Z = MandelbulbMath::Select(ActiveMask, NewZ + CZ, Z);
+		}
+
+		return true;
+	}
+}
+
+int32 FOrbitSeriesApproximation::GetBucket(double DeltaLength)
+{
+	if (DeltaLength > 1.0)
+	{
+		return INDEX_NONE;
+	}
+	if (DeltaLength <= 0.0)
+	{
+		return NumRadiusBuckets - 1;
+	}
+
+	// Largest k with DeltaLength <= 2^-k; the correction guards against log2 rounding at exact powers of two
+	int32 Bucket = FMath::Min(FMath::FloorToInt32(-FMath::Log2(DeltaLength)), NumRadiusBuckets - 1);
+	if (Bucket > 0 && DeltaLength > FMath::Exp2(-static_cast<double>(Bucket)))
+	{
+		--Bucket;
+	}
+	return Bucket;
+}
+
+void FOrbitSeriesApproximation::SetBucket(int32 Bucket, int32 SkipIteration, const FVector3d (&Columns)[3], double RunningDerivative)
+{
+	check(Bucket >= 0 && Bucket < NumRadiusBuckets);
+	if (!IsValid())
+	{
+		GpuData.SetNumZeroed(NumRadiusBuckets * TexelsPerBucket);
+	}
+
+	// Rows of A so the shader evaluates each component of eps with one dot product. dr rides along so the
+	// shader can seed the DE without reading the orbit's derivative channel, which compact orbits drop.
+	const float W[3] = { static_cast<float>(SkipIteration), static_cast<float>(RunningDerivative), 0.0f };
+	for (int32 Row = 0; Row < 3; ++Row)
+	{
+		GpuData[Bucket * TexelsPerBucket + Row] = FVector4f(
+			static_cast<float>(Columns[0][Row]),
+			static_cast<float>(Columns[1][Row]),
+			static_cast<float>(Columns[2][Row]),
+			W[Row]);
+	}
+}
+
+int32 FOrbitSeriesApproximation::GetSkipIteration(int32 Bucket) const
+{
+	if (!IsValid() || Bucket < 0 || Bucket >= NumRadiusBuckets)
+	{
+		return 0;
+	}
+	return static_cast<int32>(GpuData[Bucket * TexelsPerBucket].W);
+}
+
+double FOrbitSeriesApproximation::GetStartDerivative(int32 Bucket) const
+{
+	if (!IsValid() || Bucket < 0 || Bucket >= NumRadiusBuckets)
+	{
+		return 1.0;
+	}
+	return GpuData[Bucket * TexelsPerBucket + 1].W;
+}
+
+FVector3d FOrbitSeriesApproximation::Evaluate(int32 Bucket, const FVector3d& Delta) const
+{
+	if (!IsValid() || Bucket < 0 || Bucket >= NumRadiusBuckets)
+	{
+		return FVector3d::ZeroVector;
+	}
+
+	FVector3d Result;
+	for (int32 Row = 0; Row < 3; ++Row)
+	{
+		const FVector4f& Coefficients = GpuData[Bucket * TexelsPerBucket + Row];
+		Result[Row] = Coefficients.X * Delta.X + Coefficients.Y * Delta.Y + Coefficients.Z * Delta.Z;
+	}
+	return Result;
+}
+
+int32 FOrbitSeriesApproximation::GetMaxSkipIteration() const
+{
+	int32 MaxSkipIteration = 0;
+	for (int32 Bucket = 0; Bucket < NumRadiusBuckets && IsValid(); ++Bucket)
+	{
+		MaxSkipIteration = FMath::Max(MaxSkipIteration, GetSkipIteration(Bucket));
+	}
+	return MaxSkipIteration;
+}
+
+void FOrbitSeriesApproximation::ClampToLength(int32 InLength, double InitialDerivative)
+{
+	if (!IsValid())
+	{
+		return;
+	}
+
+	// S_k grows with k, so buckets are clamped in order and each copies an already clamped neighbour
+	const int32 LastIteration = FMath::Max(InLength - 1, 0);
+	for (int32 Bucket = 0; Bucket < NumRadiusBuckets; ++Bucket)
+	{
+		if (GetSkipIteration(Bucket) <= LastIteration)
+		{
+			continue;
+		}
+
+		bHasClampedBuckets = true;
+		if (Bucket > 0)
+		{
+			for (int32 Row = 0; Row < TexelsPerBucket; ++Row)
+			{
+				GpuData[Bucket * TexelsPerBucket + Row] = GpuData[(Bucket - 1) * TexelsPerBucket + Row];
+			}
+		}
+		else
+		{
+			const FVector3d NoColumns[3] = { FVector3d::ZeroVector, FVector3d::ZeroVector, FVector3d::ZeroVector };
+			SetBucket(Bucket, 0, NoColumns, InitialDerivative);
+		}
+	}
+}
+
+FReferenceOrbit::FReferenceOrbit(const FReferenceOrbit& Other, int32 InCapacity)
+	: ReferenceCenter(Other.ReferenceCenter)
+	, Power(Other.Power)
+	, BailoutRadius(Other.BailoutRadius)
+	, EscapeIteration(Other.EscapeIteration)
+	, Precision(Other.Precision)
+	, bValid(Other.bValid)
+	, bHasDerivatives(Other.bHasDerivatives)
+	, ResumeState(Other.ResumeState)
+	, SeriesApproximation(Other.SeriesApproximation)
+	, NumPoints(Other.NumPoints)
+	, NumComputedPoints(Other.NumComputedPoints)
+	, ComputedEscapeIteration(Other.ComputedEscapeIteration)
+	, Capacity(FMath::Max(InCapacity, Other.NumComputedPoints))
+{
+	Other.CopyComputedPoints(Storage, Capacity);
+}
+
+void FReferenceOrbit::Reserve(int32 InCapacity)
+{
+	if (InCapacity <= Capacity)
+	{
+		return;
+	}
+
+	// The float3 views are packed 12-byte elements that only need alignof(FVector3f), which any capacity of the
+	// double channels before them already satisfies, so the capacity is not rounded
+	TArray<uint8> NewStorage;
+	CopyComputedPoints(NewStorage, InCapacity);
+
+	Storage = MoveTemp(NewStorage);
+	Capacity = InCapacity;
+}
+
+void FReferenceOrbit::CopyComputedPoints(TArray<uint8>& OutStorage, int32 OutCapacity) const
+{
+	check(OutCapacity >= NumComputedPoints);
+	OutStorage.SetNumUninitialized(GetStorageSize(OutCapacity));
+
+	if (NumComputedPoints > 0)
+	{
+		// Each channel moves to its new offset; only the computed prefix is copied
+		for (int32 Channel = 0; Channel < 3; ++Channel)
+		{
+			FMemory::Memcpy(
+				OutStorage.GetData() + SIZE_T(Channel) * OutCapacity * sizeof(double),
+				GetChannel(Channel),
+				SIZE_T(NumComputedPoints) * sizeof(double));
+		}
+		FMemory::Memcpy(OutStorage.GetData() + GetGpuPositionOffset(OutCapacity), GetGpuPositionData(), SIZE_T(NumComputedPoints) * sizeof(FVector3f));
+		FMemory::Memcpy(OutStorage.GetData() + GetGpuDerivativeOffset(OutCapacity), GetGpuDerivativeData(), SIZE_T(NumComputedPoints) * sizeof(FVector3f));
+	}
+}
+
+void FReferenceOrbit::SetIterationLimit(int32 InMaxIterations)
+{
+	NumPoints = FMath::Clamp(InMaxIterations + 1, 0, NumComputedPoints);
+	EscapeIteration = (ComputedEscapeIteration >= 0 && ComputedEscapeIteration < NumPoints) ? ComputedEscapeIteration : -1;
+}
+
+void FReferenceOrbit::DiscardFrom(int32 InLength)
+{
+	NumComputedPoints = FMath::Clamp(InLength, 0, NumComputedPoints);
+	NumPoints = FMath::Min(NumPoints, NumComputedPoints);
+	if (ComputedEscapeIteration >= NumComputedPoints)
+	{
+		ComputedEscapeIteration = -1;
+	}
+	if (EscapeIteration >= NumPoints)
+	{
+		EscapeIteration = -1;
+	}
+}
+
+int32 FReferenceOrbit::AddPoint(const FVector3d& Position)
+{
+	// Appending past a truncated limit would interleave new points with retained ones
+	check(NumPoints == NumComputedPoints);
+
+	if (NumComputedPoints == Capacity)
+	{
+		Reserve(FMath::Max(Capacity * 2, 64));
+	}
+
+	const int32 Index = NumComputedPoints++;
+	NumPoints = NumComputedPoints;
+	GetChannel(0)[Index] = Position.X;
+	GetChannel(1)[Index] = Position.Y;
+	GetChannel(2)[Index] = Position.Z;
+	GetGpuPositionData()[Index] = FVector3f(
+		static_cast<float>(Position.X),
+		static_cast<float>(Position.Y),
+		static_cast<float>(Position.Z));
+	GetGpuDerivativeData()[Index] = FVector3f(0.0f, 0.0f, 0.0f);
+	return Index;
+}
+
+void FReferenceOrbit::MarkEscaped(int32 Index)
+{
+	check(Index >= 0 && Index < NumComputedPoints);
+	ComputedEscapeIteration = Index;
+	EscapeIteration = Index < NumPoints ? Index : -1;
+}
+
+void FReferenceOrbit::SetDerivative(int32 Index, double RunningDerivative, double Scale, double Radius)
+{
+	check(Index >= 0 && Index < NumPoints);
+	GetGpuDerivativeData()[Index] = FVector3f(
+		static_cast<float>(RunningDerivative),
+		static_cast<float>(Scale),
+		static_cast<float>(Radius));
+}
+
+FVector3d FReferenceOrbit::GetPosition(int32 Index) const
+{
+	check(Index >= 0 && Index < NumPoints);
+	return FVector3d(GetChannel(0)[Index], GetChannel(1)[Index], GetChannel(2)[Index]);
+}
+
+FVector3d FReferenceOrbit::GetDerivative(int32 Index) const
+{
+	check(Index >= 0 && Index < NumPoints);
+	const FVector3f& Derivative = GetGpuDerivativeData()[Index];
+	return FVector3d(Derivative.X, Derivative.Y, Derivative.Z);
+}
+
 FMandelbulbOrbitGenerator::FMandelbulbOrbitGenerator()
 {
 }
@@ -15,138 +727,284 @@ FReferenceOrbit FMandelbulbOrbitGenerator::GenerateOrbit(
 	const FVector3d& ReferenceCenter,
 	double Power,
 	int32 MaxIterations,
-	double BailoutRadius
+	double BailoutRadius,
+	const TFunction<bool()>& ShouldCancel,
+	EFractalOrbitPrecision Precision
 ) const
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FMandelbulbOrbitGenerator::GenerateOrbit);
+	if (Precision == EFractalOrbitPrecision::DoubleDouble)
+	{
+		return GenerateOrbit(MandelbulbMath::TVec3<FDoubleDouble>(ReferenceCenter), Power, MaxIterations, BailoutRadius, ShouldCancel);
+	}
+
+	return GenerateOrbit(MandelbulbMath::TVec3<double>(ReferenceCenter), Power, MaxIterations, BailoutRadius, ShouldCancel);
+}
+
+template <typename RealType>
+FReferenceOrbit FMandelbulbOrbitGenerator::GenerateOrbit(
+	const MandelbulbMath::TVec3<RealType>& ReferenceCenter,
+	double Power,
+	int32 MaxIterations,
+	double BailoutRadius,
+	const TFunction<bool()>& ShouldCancel
+) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FractalOrbitGeneration);
+	FRACTAL_TRACE_SCOPE(FMandelbulbOrbitGenerator::GenerateOrbit);
 
 	FReferenceOrbit Result;
-	Result.ReferenceCenter = ReferenceCenter;
+	Result.ReferenceCenter = ReferenceCenter.ToVector3d();
 	Result.Power = Power;
 	Result.BailoutRadius = BailoutRadius;
 	Result.EscapeIteration = -1;
+	Result.Precision = std::is_same_v<RealType, FDoubleDouble> ? EFractalOrbitPrecision::DoubleDouble : EFractalOrbitPrecision::Double;
 	Result.bValid = false;
 	Result.bHasDerivatives = false;
 
-	// Reserve space for orbit points
-	Result.Points.Reserve(MaxIterations);
+	// Reserve space for orbit points (z_0 plus one per iteration)
+	Result.Reserve(MaxIterations + 1);
 
-	// Initial point: z_0 = 0
-	FVector3d Z = FVector3d::ZeroVector;
-	FVector3d DzDc = FVector3d::ZeroVector;
-	Result.Points.Add(FOrbitPoint(Z, DzDc, 0, false));
-
-	// Iterate Mandelbulb formula: z_{n+1} = g_p(z_n) + C_0
-	// Following the research pseudocode exactly
-	for (int32 Iteration = 0; Iteration < MaxIterations; ++Iteration)
+	// Integer powers 2..8 use the trig-free polynomial expansion; anything else falls back to trig
+	MandelbulbMath::DispatchPower(Power, [&]<int32 P>()
 	{
-		// Extract components
-		double X = Z.X;
-		double Y = Z.Y;
-		double ZVal = Z.Z;
+		IterateOrbit<RealType, P>(Result, ReferenceCenter, MaxIterations, ShouldCancel);
+	});
+
+	// Mark as valid if we have at least one point
+	Result.bValid = Result.GetLength() > 0;
 
-		// Compute radius: r = sqrt(x^2 + y^2 + z^2)
-		double R = FMath::Sqrt(X * X + Y * Y + ZVal * ZVal);
+	// Iteration skip table for the perturbation DE; a cancelled orbit is discarded by the caller anyway
+	ComputeSeriesApproximation(Result, ShouldCancel);
 
-		// Check bailout condition
-		if (R > BailoutRadius)
+	UE_LOG(LogMandelbulbOrbit, Verbose, 
+		TEXT("Generated orbit: Center=(%.6f, %.6f, %.6f), Power=%.2f, Precision=%s, Iterations=%d, Escaped=%s at iter %d, Skip=%d at |delta|=1e-6, Memory=%.1f KB"),
+		Result.ReferenceCenter.X, Result.ReferenceCenter.Y, Result.ReferenceCenter.Z,
+		Power,
+		Result.Precision == EFractalOrbitPrecision::DoubleDouble ? TEXT("double-double") : TEXT("double"),
+		Result.GetLength(),
+		Result.EscapeIteration >= 0 ? TEXT("Yes") : TEXT("No"),
+		Result.EscapeIteration,
+		Result.SeriesApproximation.GetSkipIteration(FOrbitSeriesApproximation::GetBucket(1e-6)),
+		Result.GetAllocatedSize() / 1024.0
+	);
+
+	return Result;
+}
+
+bool FMandelbulbOrbitGenerator::ExtendOrbit(
+	FReferenceOrbit& Orbit,
+	int32 MaxIterations,
+	const TFunction<bool()>& ShouldCancel
+) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FractalOrbitGeneration);
+	FRACTAL_TRACE_SCOPE(FMandelbulbOrbitGenerator::ExtendOrbit);
+
+	const int32 PreviousLength = Orbit.GetLength();
+	const int32 PreviousComputedLength = Orbit.GetComputedLength();
+	const FReferenceOrbit::FResumeState PreviousResumeState = Orbit.ResumeState;
+
+	// Truncation, or raising the limit within points that were already computed
+	Orbit.SetIterationLimit(MaxIterations);
+	if (Orbit.GetLength() == MaxIterations + 1 || !Orbit.CanResume())
+	{
+		// A bucket's entry only depends on the prefix it covers. Shortening keeps the table, clamping buckets that
+		// skip past the new end; growing rebuilds it if some bucket was still valid at the previous end, or was
+		// clamped by an earlier truncation and would otherwise keep its shallower skip.
+		if (Orbit.GetLength() < PreviousLength)
 		{
-			Result.EscapeIteration = Iteration;
-			Result.Points.Last().bEscaped = true;
-			break;
+			Orbit.SeriesApproximation.ClampToLength(Orbit.GetLength(), Orbit.GetLength() > 0 ? Orbit.GetDerivative(0).X : 1.0);
+		}
+		else if (Orbit.GetLength() > PreviousLength
+			&& (Orbit.SeriesApproximation.GetMaxSkipIteration() >= PreviousLength - 1 || Orbit.SeriesApproximation.bHasClampedBuckets)
+			&& !ComputeSeriesApproximation(Orbit, ShouldCancel))
+		{
+			Orbit.SetIterationLimit(PreviousLength - 1);
+			return false;
 		}
 
-		// Convert to spherical coordinates
-		// Handle edge cases where r is very small to avoid division by zero
-		double Theta = 0.0;
-		double Phi = 0.0;
+		Orbit.bValid = Orbit.GetLength() > 0;
+		return true;
+	}
 
-		if (R > 1e-10)
-		{
-			// theta = acos(z/r), clamped to [-1, 1] for numerical stability
-			double CosTheta = FMath::Clamp(ZVal / R, -1.0, 1.0);
-			Theta = FMath::Acos(CosTheta);
+	// Only the missing tail is iterated; the prefix and its derivatives are reused as-is
+	Orbit.Reserve(MaxIterations + 1);
 
-			// phi = atan2(y, x)
-			Phi = FMath::Atan2(Y, X);
+	bool bCompleted = false;
+	MandelbulbMath::DispatchPower(Orbit.Power, [&]<int32 P>()
+	{
+		if (Orbit.Precision == EFractalOrbitPrecision::DoubleDouble)
+		{
+			const auto C = JoinVector<FDoubleDouble>(Orbit.ReferenceCenter, Orbit.ResumeState.CenterLow);
+			bCompleted = IterateOrbit<FDoubleDouble, P>(Orbit, C, MaxIterations, ShouldCancel);
 		}
+		else
+		{
+			bCompleted = IterateOrbit<double, P>(Orbit, MandelbulbMath::TVec3<double>(Orbit.ReferenceCenter), MaxIterations, ShouldCancel);
+		}
+	});
 
-		// Apply power transformation in spherical space
-		// r_new = r^p
-		double RPowered = FMath::Pow(R, Power);
-
-		// theta_new = p * theta
-		double ThetaNew = Power * Theta;
+	if (bCompleted && !ComputeSeriesApproximation(Orbit, ShouldCancel))
+	{
+		// The tail was iterated but its table was not; roll back so the orbit and table stay consistent
+		Orbit.DiscardFrom(PreviousComputedLength);
+		Orbit.ResumeState = PreviousResumeState;
+		bCompleted = false;
+	}
 
-		// phi_new = p * phi
-		double PhiNew = Power * Phi;
+	if (!bCompleted)
+	{
+		Orbit.SetIterationLimit(PreviousLength - 1);
+		return false;
+	}
 
-		// Convert back to Cartesian coordinates
-		// x = r * sin(theta) * cos(phi)
-		// y = r * sin(theta) * sin(phi)
-		// z = r * cos(theta)
-		double SinTheta = FMath::Sin(ThetaNew);
-		double CosTheta = FMath::Cos(ThetaNew);
-		double SinPhi = FMath::Sin(PhiNew);
-		double CosPhi = FMath::Cos(PhiNew);
+	UE_LOG(LogMandelbulbOrbit, Verbose,
+		TEXT("Extended orbit: %d -> %d points (%d iterated), Escaped=%s at iter %d"),
+		PreviousLength, Orbit.GetLength(), Orbit.GetComputedLength() - PreviousComputedLength,
+		Orbit.EscapeIteration >= 0 ? TEXT("Yes") : TEXT("No"),
+		Orbit.EscapeIteration
+	);
 
-		Z.X = RPowered * SinTheta * CosPhi;
-		Z.Y = RPowered * SinTheta * SinPhi;
-		Z.Z = RPowered * CosTheta;
+	return true;
+}
 
-		// Add constant C (reference center)
-		Z += ReferenceCenter;
+bool FMandelbulbOrbitGenerator::ComputeSeriesApproximation(
+	FReferenceOrbit& Orbit,
+	const TFunction<bool()>& ShouldCancel,
+	double Tolerance
+) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FractalSeriesApproximation);
+	FRACTAL_TRACE_SCOPE(FMandelbulbOrbitGenerator::ComputeSeriesApproximation);
 
-		// TODO: Compute derivative update once perturbation Jacobian is implemented
-		// Placeholder keeps derivative zero so downstream code can begin consuming the data now.
-		Result.Points.Add(FOrbitPoint(Z, DzDc, Iteration + 1, false));
+	// Jets need the polynomial power map; the trig fallback keeps starting perturbation at 0
+	if (!Orbit.IsValid() || MandelbulbMath::GetPolynomialPower(Orbit.Power) == 0)
+	{
+		Orbit.SeriesApproximation.Reset();
+		return true;
 	}
 
-	// Mark as valid if we have at least one point
-	Result.bValid = Result.Points.Num() > 0;
+	FOrbitSeriesApproximation Table;
+	bool bCompleted = false;
+	MandelbulbMath::DispatchPower(Orbit.Power, [&]<int32 P>()
+	{
+		if constexpr (P > 0)
+		{
+			bCompleted = BuildSeriesApproximation<P>(Orbit, Tolerance, ShouldCancel, Table);
+		}
+	});
 
-	UE_LOG(LogMandelbulbOrbit, Verbose, 
-		TEXT("Generated orbit: Center=(%.6f, %.6f, %.6f), Power=%.2f, Iterations=%d, Escaped=%s at iter %d"),
-		ReferenceCenter.X, ReferenceCenter.Y, ReferenceCenter.Z,
-		Power,
-		Result.Points.Num(),
-		Result.EscapeIteration >= 0 ? TEXT("Yes") : TEXT("No"),
-		Result.EscapeIteration
-	);
+	if (!bCompleted)
+	{
+		UE_LOG(LogMandelbulbOrbit, Verbose, TEXT("Series approximation cancelled"));
+		return false;
+	}
 
-	return Result;
+	Orbit.SeriesApproximation = MoveTemp(Table);
+	return true;
 }
 
-void FMandelbulbOrbitGenerator::ConvertOrbitToFloat(
-	const FReferenceOrbit& Orbit,
-	TArray<FVector4f>& OutPositionData,
-	TArray<FVector4f>& OutDerivativeData
-)
+FReferenceCenterSearchResult FMandelbulbOrbitGenerator::SelectReferenceCenter(
+	const FVector3d& ViewCenter,
+	double SearchRadius,
+	double Power,
+	int32 MaxIterations,
+	double BailoutRadius,
+	int32 CandidatesPerAxis,
+	const TFunction<bool()>& ShouldCancel
+) const
 {
-	const int32 NumPoints = Orbit.Points.Num();
-	OutPositionData.Reset(NumPoints);
-	OutDerivativeData.Reset(NumPoints);
-	OutPositionData.Reserve(NumPoints);
-	OutDerivativeData.Reserve(NumPoints);
+	SCOPE_CYCLE_COUNTER(STAT_FractalReferenceSearch);
+	FRACTAL_TRACE_SCOPE(FMandelbulbOrbitGenerator::SelectReferenceCenter);
+
+	FReferenceCenterSearchResult Result;
+	Result.Center = ViewCenter;
+
+	// SIMD lanes need the polynomial power map; the trig fallback keeps the view center
+	if (MaxIterations <= 0 || MandelbulbMath::GetPolynomialPower(Power) == 0)
+	{
+		return Result;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Candidate centers as structure-of-arrays so each lane group is one load per coordinate
+	TArray<double> CandidateX;
+	TArray<double> CandidateY;
+	TArray<double> CandidateZ;
+	const auto AddCandidate = [&](const FVector3d& Center)
+	{
+		CandidateX.Add(Center.X);
+		CandidateY.Add(Center.Y);
+		CandidateZ.Add(Center.Z);
+	};
+	ForEachSearchCandidate(ViewCenter, SearchRadius, CandidatesPerAxis, AddCandidate);
+
+	// Pad to whole batches by repeating the last candidate; padded results are ignored
+	const int32 NumCandidates = CandidateX.Num();
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumCandidates, CandidatesPerSearchBatch);
+	while (CandidateX.Num() < NumBatches * CandidatesPerSearchBatch)
+	{
+		AddCandidate(FVector3d(CandidateX.Last(), CandidateY.Last(), CandidateZ.Last()));
+	}
 
-	for (const FOrbitPoint& Point : Orbit.Points)
+	TArray<FCandidateOrbitResult> CandidateResults;
+	CandidateResults.SetNum(CandidateX.Num());
+	std::atomic<bool> bCancelled{false};
+	MandelbulbMath::DispatchPower(Power, [&]<int32 P>()
 	{
-		OutPositionData.Add(FVector4f(
-			static_cast<float>(Point.Position.X),
-			static_cast<float>(Point.Position.Y),
-			static_cast<float>(Point.Position.Z),
-			0.0f
-		));
+		if constexpr (P > 0)
+		{
+			ParallelFor(NumBatches, [&](int32 Batch)
+			{
+				const int32 End = (Batch + 1) * CandidatesPerSearchBatch;
+				for (int32 First = Batch * CandidatesPerSearchBatch; First < End; First += MandelbulbMath::FDouble4::NumLanes)
+				{
+					if (bCancelled.load(std::memory_order_relaxed)
+						|| !IterateCandidateLanes<P>(&CandidateX[First], &CandidateY[First], &CandidateZ[First], MaxIterations, BailoutRadius, ShouldCancel, &CandidateResults[First]))
+					{
+						bCancelled.store(true, std::memory_order_relaxed);
+						return;
+					}
+				}
+			});
+		}
+	});
 
-		OutDerivativeData.Add(FVector4f(
-			static_cast<float>(Point.Derivative.X),
-			static_cast<float>(Point.Derivative.Y),
-			static_cast<float>(Point.Derivative.Z),
-			0.0f
-		));
+	if (bCancelled.load())
+	{
+		UE_LOG(LogMandelbulbOrbit, Verbose, TEXT("Reference center search cancelled"));
+		return Result;
 	}
+
+	const auto DistanceSq = [&](int32 Index)
+	{
+		return FVector3d::DistSquared(FVector3d(CandidateX[Index], CandidateY[Index], CandidateZ[Index]), ViewCenter);
+	};
+	const int32 Best = PickSearchCandidate(TConstArrayView<FCandidateOrbitResult>(CandidateResults.GetData(), NumCandidates), MaxIterations, DistanceSq);
+
+	Result.Center = FVector3d(CandidateX[Best], CandidateY[Best], CandidateZ[Best]);
+	Result.EscapeIteration = CandidateResults[Best].EscapeIteration;
+	Result.Period = CandidateResults[Best].Period;
+	Result.BaselineEscapeIteration = CandidateResults[0].EscapeIteration;
+	Result.NumCandidates = NumCandidates;
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+	Result.bCompleted = true;
+
+	UE_LOG(LogMandelbulbOrbit, Verbose,
+		TEXT("Reference center search: %d candidates in %.2f ms, chosen orbit length %d (period %d, offset %.3e), view center length %d"),
+		NumCandidates, Result.Seconds * 1000.0,
+		Result.GetOrbitLength(MaxIterations), Result.Period, FMath::Sqrt(DistanceSq(Best)),
+		Result.GetBaselineOrbitLength(MaxIterations));
+
+	return Result;
 }
 
+template FReferenceOrbit FMandelbulbOrbitGenerator::GenerateOrbit<double>(
+	const MandelbulbMath::TVec3<double>&, double, int32, double, const TFunction<bool()>&) const;
+template FReferenceOrbit FMandelbulbOrbitGenerator::GenerateOrbit<FDoubleDouble>(
+	const MandelbulbMath::TVec3<FDoubleDouble>&, double, int32, double, const TFunction<bool()>&) const;
+
 FVector3d FMandelbulbOrbitGenerator::MandelbulbIteration(
 	const FVector3d& Z,
 	const FVector3d& C,
@@ -154,66 +1012,249 @@ FVector3d FMandelbulbOrbitGenerator::MandelbulbIteration(
 )
 {
 	// Apply spherical power transform then add constant
-	return SphericalPowerTransform(Z, Power) + C;
+	return MandelbulbMath::DispatchPower(Power, [&]<int32 P>()
+	{
+		return MandelbulbMath::PowerMap<P>(Z, Power);
+	}) + C;
 }
 
-FVector3d FMandelbulbOrbitGenerator::CartesianToSpherical(const FVector3d& Cartesian)
+namespace
 {
-	double X = Cartesian.X;
-	double Y = Cartesian.Y;
-	double Z = Cartesian.Z;
+	/**
+	 * Fractal.BenchmarkOrbit [Iterations] [Power] [Orbits]
+	 * Times the compile-time polynomial power map against the trig implementation on the same
+	 * set of reference centers. Fractal.Orbit.PowerMap (automation) checks the two agree.
+	 */
+	void BenchmarkOrbitGeneration(const TArray<FString>& InArgs)
+	{
+		const FFractalOrbitBenchmarkArgs Args(InArgs, 10000, 64);
+		const int32 MaxIterations = Args.MaxIterations;
+		const double Power = Args.Power;
+		const int32 NumOrbits = Args.NumOrbits;
+		const double BailoutRadius = 2.0;
 
-	// r = sqrt(x^2 + y^2 + z^2)
-	double R = FMath::Sqrt(X * X + Y * Y + Z * Z);
+		if (!Args.HasPolynomialPower())
+		{
+			UE_LOG(LogMandelbulbOrbit, Display, TEXT("%s"), *Args.DescribeUnsupportedPower(TEXT("Fractal.BenchmarkOrbit")));
+			return;
+		}
+
+		// Fixed seed so both paths see identical reference centers
+		FRandomStream Stream(1337);
+		TArray<FVector3d> Centers;
+		for (int32 Index = 0; Index < NumOrbits; ++Index)
+		{
+			Centers.Add(FVector3d(Stream.FRandRange(-1.2, 1.2), Stream.FRandRange(-1.2, 1.2), Stream.FRandRange(-1.2, 1.2)));
+		}
+
+		const auto RunPath = [&](auto&& Iterate, TArray<FReferenceOrbit>& OutOrbits, int64& OutIterations)
+		{
+			OutIterations = 0;
+			const double StartTime = FPlatformTime::Seconds();
+			for (const FVector3d& Center : Centers)
+			{
+				FReferenceOrbit& Orbit = OutOrbits.AddDefaulted_GetRef();
+				Orbit.ReferenceCenter = Center;
+				Orbit.Power = Power;
+				Orbit.BailoutRadius = BailoutRadius;
+				Orbit.Reserve(MaxIterations + 1);
+				Iterate(Orbit);
+				OutIterations += Orbit.GetLength();
+			}
+			return FPlatformTime::Seconds() - StartTime;
+		};
 
-	// Avoid division by zero
-	if (R < 1e-10)
+		TArray<FReferenceOrbit> TrigOrbits;
+		TArray<FReferenceOrbit> PolynomialOrbits;
+		TArray<FReferenceOrbit> ExtendedOrbits;
+		int64 TrigIterations = 0;
+		int64 PolynomialIterations = 0;
+		int64 ExtendedIterations = 0;
+
+		const double TrigSeconds = RunPath([&](FReferenceOrbit& Orbit)
+		{
+			IterateOrbit<double, 0>(Orbit, MandelbulbMath::TVec3<double>(Orbit.ReferenceCenter), MaxIterations, TFunction<bool()>());
+		}, TrigOrbits, TrigIterations);
+		const double PolynomialSeconds = RunPath([&](FReferenceOrbit& Orbit)
+		{
+			MandelbulbMath::DispatchPower(Power, [&]<int32 P>()
+			{
+				IterateOrbit<double, P>(Orbit, MandelbulbMath::TVec3<double>(Orbit.ReferenceCenter), MaxIterations, TFunction<bool()>());
+			});
+		}, PolynomialOrbits, PolynomialIterations);
+		const double ExtendedSeconds = RunPath([&](FReferenceOrbit& Orbit)
+		{
+			MandelbulbMath::DispatchPower(Power, [&]<int32 P>()
+			{
+				IterateOrbit<FDoubleDouble, P>(Orbit, MandelbulbMath::TVec3<FDoubleDouble>(Orbit.ReferenceCenter), MaxIterations, TFunction<bool()>());
+			});
+		}, ExtendedOrbits, ExtendedIterations);
+
+		const double TrigNs = TrigSeconds * 1e9 / FMath::Max<int64>(TrigIterations, 1);
+		const double PolynomialNs = PolynomialSeconds * 1e9 / FMath::Max<int64>(PolynomialIterations, 1);
+		const double ExtendedNs = ExtendedSeconds * 1e9 / FMath::Max<int64>(ExtendedIterations, 1);
+		UE_LOG(LogMandelbulbOrbit, Display,
+			TEXT("Fractal.BenchmarkOrbit: power %.0f, %d orbits x %d iterations. Trig %.2f ns/iter (%.2f ms), polynomial %.2f ns/iter (%.2f ms), speedup %.2fx"),
+			Power, NumOrbits, MaxIterations,
+			TrigNs, TrigSeconds * 1000.0,
+			PolynomialNs, PolynomialSeconds * 1000.0,
+			TrigNs / FMath::Max(PolynomialNs, 1e-9));
+		UE_LOG(LogMandelbulbOrbit, Display,
+			TEXT("Fractal.BenchmarkOrbit: double-double polynomial %.2f ns/iter (%.2f ms), %.2f ms per 10k-iteration orbit"),
+			ExtendedNs, ExtendedSeconds * 1000.0, ExtendedNs * 10000.0 * 1e-6);
+	}
+
+	FAutoConsoleCommand BenchmarkOrbitCommand(
+		TEXT("Fractal.BenchmarkOrbit"),
+		TEXT("Benchmark polynomial vs trig orbit generation. Args: [Iterations=10000] [Power=8] [Orbits=64]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkOrbitGeneration));
+
+	/**
+	 * Fractal.BenchmarkSeriesApproximation [Iterations] [Power] [Orbits]
+	 * Times orbit generation with its series table and reports how many iterations the table skips on
+	 * average, per radius bucket in use. Fractal.Orbit.SeriesApproximation (automation) checks the table.
+	 */
+	void BenchmarkSeriesApproximation(const TArray<FString>& InArgs)
 	{
-		return FVector3d(0.0, 0.0, 0.0);
+		const FFractalOrbitBenchmarkArgs Args(InArgs, 1000, 16);
+		const double BailoutRadius = 2.0;
+
+		if (!Args.HasPolynomialPower())
+		{
+			UE_LOG(LogMandelbulbOrbit, Display, TEXT("%s"), *Args.DescribeUnsupportedPower(TEXT("Fractal.BenchmarkSeriesApproximation")));
+			return;
+		}
+
+		const FMandelbulbOrbitGenerator Generator;
+		FRandomStream Stream(1337);
+
+		double GenerateSeconds = 0.0;
+		int64 NumBuckets = 0;
+		int64 SkippedIterations = 0;
+		int64 NumPoints = 0;
+		for (int32 OrbitIndex = 0; OrbitIndex < Args.NumOrbits; ++OrbitIndex)
+		{
+			const FVector3d Center(Stream.FRandRange(-1.2, 1.2), Stream.FRandRange(-1.2, 1.2), Stream.FRandRange(-1.2, 1.2));
+			const double StartTime = FPlatformTime::Seconds();
+			const FReferenceOrbit Orbit = Generator.GenerateOrbit(Center, Args.Power, Args.MaxIterations, BailoutRadius);
+			GenerateSeconds += FPlatformTime::Seconds() - StartTime;
+			NumPoints += Orbit.GetLength();
+
+			for (int32 Bucket = 0; Orbit.SeriesApproximation.IsValid() && Bucket < FOrbitSeriesApproximation::NumRadiusBuckets; ++Bucket)
+			{
+				const int32 SkipIteration = Orbit.SeriesApproximation.GetSkipIteration(Bucket);
+				if (SkipIteration > 0)
+				{
+					SkippedIterations += SkipIteration;
+					++NumBuckets;
+				}
+			}
+		}
+
+		UE_LOG(LogMandelbulbOrbit, Display,
+			TEXT("Fractal.BenchmarkSeriesApproximation: power %.0f, %d orbits x %d iterations. %.2f ms per orbit with its table (%.2f ns/point), mean skip %.1f iterations over %lld skipping buckets"),
+			Args.Power, Args.NumOrbits, Args.MaxIterations,
+			GenerateSeconds * 1000.0 / Args.NumOrbits, GenerateSeconds * 1e9 / FMath::Max<int64>(NumPoints, 1),
+			static_cast<double>(SkippedIterations) / FMath::Max<int64>(NumBuckets, 1), NumBuckets);
 	}
 
-	// theta = acos(z/r), clamped for numerical stability
-	double CosTheta = FMath::Clamp(Z / R, -1.0, 1.0);
-	double Theta = FMath::Acos(CosTheta);
+	FAutoConsoleCommand BenchmarkSeriesApproximationCommand(
+		TEXT("Fractal.BenchmarkSeriesApproximation"),
+		TEXT("Time orbit generation with its series table and report the mean skip. Args: [Iterations=1000] [Power=8] [Orbits=16]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkSeriesApproximation));
 
-	// phi = atan2(y, x)
-	double Phi = FMath::Atan2(Y, X);
+	/**
+	 * Fractal.BenchmarkReferenceSearch [Iterations] [Power] [CandidatesPerAxis] [Views]
+	 * Runs the reference center search around random view centers and compares the chosen orbit length
+	 * against the view center's own. Also times the scalar path: a full orbit for each of the same candidates,
+	 * judged by the same rule. That path must choose the same center, and the chosen candidate's escape
+	 * iteration must match its full scalar orbit.
+	 */
+	void BenchmarkReferenceSearch(const TArray<FString>& Args)
+	{
+		const int32 MaxIterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 2000;
+		const double Power = Args.Num() > 1 ? FCString::Atod(*Args[1]) : 8.0;
+		const int32 CandidatesPerAxis = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 5;
+		const int32 NumViews = Args.Num() > 3 ? FMath::Max(FCString::Atoi(*Args[3]), 1) : 32;
+		const double BailoutRadius = 2.0;
+		const double SearchRadius = 0.01;
 
-	return FVector3d(R, Theta, Phi);
-}
+		if (MandelbulbMath::GetPolynomialPower(Power) == 0)
+		{
+			UE_LOG(LogMandelbulbOrbit, Display, TEXT("Fractal.BenchmarkReferenceSearch: power %.3f has no polynomial specialization (supported: %d..%d)"),
+				Power, MandelbulbMath::MinPolynomialPower, MandelbulbMath::MaxPolynomialPower);
+			return;
+		}
 
-FVector3d FMandelbulbOrbitGenerator::SphericalToCartesian(double R, double Theta, double Phi)
-{
-	double SinTheta = FMath::Sin(Theta);
-	double CosTheta = FMath::Cos(Theta);
-	double SinPhi = FMath::Sin(Phi);
-	double CosPhi = FMath::Cos(Phi);
+		const FMandelbulbOrbitGenerator Generator;
+		FRandomStream Stream(1337);
 
-	return FVector3d(
-		R * SinTheta * CosPhi,  // x
-		R * SinTheta * SinPhi,  // y
-		R * CosTheta            // z
-	);
-}
+		double SearchSeconds = 0.0;
+		double ScalarSeconds = 0.0;
+		int64 BaselineLength = 0;
+		int64 ChosenLength = 0;
+		int32 NumImproved = 0;
+		int32 NumMismatches = 0;
+		int32 NumCandidateMismatches = 0;
+		int32 NumCenterMismatches = 0;
+		int32 NumCandidates = 0;
+		for (int32 View = 0; View < NumViews; ++View)
+		{
+			const FVector3d ViewCenter(Stream.FRandRange(-1.2, 1.2), Stream.FRandRange(-1.2, 1.2), Stream.FRandRange(-1.2, 1.2));
+			const FReferenceCenterSearchResult Search = Generator.SelectReferenceCenter(ViewCenter, SearchRadius, Power, MaxIterations, BailoutRadius, CandidatesPerAxis);
+			SearchSeconds += Search.Seconds;
+			NumCandidates = Search.NumCandidates;
 
-FVector3d FMandelbulbOrbitGenerator::SphericalPowerTransform(const FVector3d& Z, double Power)
-{
-	// Convert to spherical
-	FVector3d Spherical = CartesianToSpherical(Z);
-	double R = Spherical.X;
-	double Theta = Spherical.Y;
-	double Phi = Spherical.Z;
+			const int32 Baseline = Search.GetBaselineOrbitLength(MaxIterations);
+			BaselineLength += Baseline;
+			ChosenLength += Search.GetOrbitLength(MaxIterations);
+			NumImproved += Search.GetOrbitLength(MaxIterations) > Baseline ? 1 : 0;
+
+			// Scalar equivalent: a full orbit per candidate, over the same candidates and with the same choice rule
+			TArray<FVector3d> Candidates;
+			ForEachSearchCandidate(ViewCenter, SearchRadius, CandidatesPerAxis, [&Candidates](const FVector3d& Center) { Candidates.Add(Center); });
 
-	// Apply power transformation
-	// r_new = r^p
-	double RPowered = FMath::Pow(R, Power);
+			TArray<FCandidateOrbitResult> ScalarResults;
+			const double ScalarStart = FPlatformTime::Seconds();
+			for (const FVector3d& Candidate : Candidates)
+			{
+				FReferenceOrbit Orbit;
+				Orbit.ReferenceCenter = Candidate;
+				Orbit.Power = Power;
+				Orbit.BailoutRadius = BailoutRadius;
+				Orbit.Reserve(MaxIterations + 1);
+				MandelbulbMath::DispatchPower(Power, [&]<int32 P>()
+				{
+					IterateOrbit<double, P>(Orbit, MandelbulbMath::TVec3<double>(Orbit.ReferenceCenter), MaxIterations, TFunction<bool()>());
+				});
+				ScalarResults.Add(GetCandidateResult(Orbit, MaxIterations));
+			}
+			const int32 ScalarBest = PickSearchCandidate(ScalarResults, MaxIterations, [&](int32 Index) { return FVector3d::DistSquared(Candidates[Index], ViewCenter); });
+			ScalarSeconds += FPlatformTime::Seconds() - ScalarStart;
 
-	// theta_new = p * theta
-	double ThetaNew = Power * Theta;
+			NumCandidateMismatches += Candidates.Num() != Search.NumCandidates ? 1 : 0;
+			NumCenterMismatches += Candidates[ScalarBest] != Search.Center ? 1 : 0;
 
-	// phi_new = p * phi
-	double PhiNew = Power * Phi;
+			// Lanes must reproduce the scalar recurrence exactly; periodic candidates stay bounded either way
+			const FReferenceOrbit Chosen = Generator.GenerateOrbit(Search.Center, Power, MaxIterations, BailoutRadius);
+			NumMismatches += Chosen.GetLength() != Search.GetOrbitLength(MaxIterations) ? 1 : 0;
+		}
+
+		UE_LOG(LogMandelbulbOrbit, Display,
+			TEXT("Fractal.BenchmarkReferenceSearch: power %.0f, %d views x %d candidates x %d iterations. Search %.2f ms/view, scalar per-candidate orbits %.2f ms/view, speedup %.2fx"),
+			Power, NumViews, NumCandidates, MaxIterations,
+			SearchSeconds * 1000.0 / NumViews, ScalarSeconds * 1000.0 / NumViews, ScalarSeconds / FMath::Max(SearchSeconds, 1e-9));
+		UE_LOG(LogMandelbulbOrbit, Display,
+			TEXT("Fractal.BenchmarkReferenceSearch: mean orbit length %.1f with search vs %.1f center-only, improved in %d/%d views"),
+			static_cast<double>(ChosenLength) / NumViews, static_cast<double>(BaselineLength) / NumViews, NumImproved, NumViews);
+		UE_LOG(LogMandelbulbOrbit, Display,
+			TEXT("Fractal.BenchmarkReferenceSearch: %d escape mismatches against the scalar orbit, %d views with a different candidate count, %d views where scalar chose another center (%s)"),
+			NumMismatches, NumCandidateMismatches, NumCenterMismatches,
+			NumMismatches + NumCandidateMismatches + NumCenterMismatches == 0 ? TEXT("equivalent") : TEXT("MISMATCH"));
+	}
 
-	// Convert back to Cartesian
-	return SphericalToCartesian(RPowered, ThetaNew, PhiNew);
+	FAutoConsoleCommand BenchmarkReferenceSearchCommand(
+		TEXT("Fractal.BenchmarkReferenceSearch"),
+		TEXT("Compare SIMD reference center search against the center-only choice and scalar candidate orbits. Args: [Iterations=2000] [Power=8] [CandidatesPerAxis=5] [Views=32]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkReferenceSearch));
 }
@@ -4,11 +4,15 @@
 #include "RenderTargetPool.h"
 #include "PixelShaderUtils.h"
 #include "ShaderCompilerCore.h"
+#include "FractalStats.h"
 
-DECLARE_STATS_GROUP(TEXT("PerturbationShader"), STATGROUP_PerturbationShader, STATCAT_Advanced);
-DECLARE_CYCLE_STAT(TEXT("PerturbationShader Execute"), STAT_PerturbationShader_Execute, STATGROUP_PerturbationShader);
+DECLARE_CYCLE_STAT(TEXT("PerturbationShader Execute"), STAT_PerturbationShader_Execute, STATGROUP_Fractal);
+DECLARE_GPU_STAT(PerturbationShader);
 
 IMPLEMENT_GLOBAL_SHADER(FPerturbationComputeShader, "/FractalRendererShaders/PerturbationShader.usf", "PerturbationShader", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FFractalConeMarchCS, "/FractalRendererShaders/PerturbationShader.usf", "ConeMarchPrepass", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FFractalUpscaleCS, "/FractalRendererShaders/FractalUpscale.usf", "UpscaleFractal", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FFractalMarchHistogramCS, "/FractalRendererShaders/FractalMarchHistogram.usf", "BuildMarchHistogram", SF_Compute);
 
 void FPerturbationShaderInterface::DispatchRenderThread(
 	FRHICommandListImmediate& RHICmdList,
@@ -29,6 +33,7 @@ void FPerturbationShaderInterface::DispatchRenderThread(
 
 	{
 		SCOPE_CYCLE_COUNTER(STAT_PerturbationShader_Execute);
+		FRACTAL_TRACE_SCOPE(FPerturbationShaderInterface::DispatchRenderThread);
 		RDG_EVENT_SCOPE(GraphBuilder, "PerturbationShader");
 		RDG_GPU_STAT_SCOPE(GraphBuilder, PerturbationShader);
 
@@ -49,6 +54,7 @@ void FPerturbationShaderInterface::DispatchRenderThread(
 			PassParameters->MinIterations = Params.MinIterations;
 			PassParameters->ConvergenceFactor = Params.ConvergenceFactor;
 			PassParameters->FractalPower = Params.FractalPower;
+			PassParameters->ComposeBackground = 1;
 
 			// Get the render target resource
 			FTextureRenderTargetResource* RTResource = Params.OutputRenderTarget->GameThread_GetRenderTargetResource();
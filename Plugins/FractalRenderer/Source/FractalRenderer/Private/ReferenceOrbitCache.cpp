@@ -0,0 +1,122 @@
+#include "ReferenceOrbitCache.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFractalOrbitCache, Log, All);
+
+namespace
+{
+	// Finest center grid; keeps quantized coordinates well inside int64 for |Center| < 16
+	constexpr int32 MinCenterExponent = -58;
+
+	int64 QuantizeCenter(double Value, double CellSize)
+	{
+		const double Scaled = FMath::RoundToDouble(Value / CellSize);
+		return static_cast<int64>(FMath::Clamp(Scaled, -4.0e18, 4.0e18));
+	}
+}
+
+FOrbitCacheKey FOrbitCacheKey::Make(const FFractalParameter& Params, double CenterCellSize, EFractalOrbitPrecision ResolvedPrecision)
+{
+	FOrbitCacheKey Key;
+
+	// Round the cell size down to a power of two so nearby zoom levels share a grid
+	Key.CenterExponent = FMath::Max(FMath::FloorToInt32(FMath::Log2(FMath::Max(CenterCellSize, DBL_MIN))), MinCenterExponent);
+	const double CellSize = FMath::Pow(2.0, static_cast<double>(Key.CenterExponent));
+
+	Key.CenterX = QuantizeCenter(Params.Center.X, CellSize);
+	Key.CenterY = QuantizeCenter(Params.Center.Y, CellSize);
+	Key.PowerMilli = FMath::RoundToInt32(Params.FractalPower * 1000.0);
+	Key.BailoutMilli = FMath::RoundToInt32(Params.BailoutRadius * 1000.0);
+	Key.MaxIterations = Params.MaxIterations;
+	Key.Precision = ResolvedPrecision;
+	return Key;
+}
+
+FReferenceOrbitCache::FOrbitRef FReferenceOrbitCache::Find(const FOrbitCacheKey& Key)
+{
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		Entry->LastUsed = ++UseCounter;
+		++Hits;
+		return Entry->Orbit;
+	}
+
+	++Misses;
+	return nullptr;
+}
+
+void FReferenceOrbitCache::Add(const FOrbitCacheKey& Key, FOrbitRef Orbit)
+{
+	if (!Orbit.IsValid())
+	{
+		return;
+	}
+
+	const SIZE_T Bytes = Orbit->GetAllocatedSize();
+	if (Bytes > BudgetBytes)
+	{
+		// Larger than the whole budget; caching it would only flush everything else
+		UE_LOG(LogFractalOrbitCache, Verbose, TEXT("Orbit of %.2f MB exceeds cache budget of %.2f MB, not cached"),
+			Bytes / (1024.0 * 1024.0), BudgetBytes / (1024.0 * 1024.0));
+		return;
+	}
+
+	if (FEntry* Existing = Entries.Find(Key))
+	{
+		UsedBytes -= Existing->Bytes;
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.Orbit = MoveTemp(Orbit);
+	Entry.Bytes = Bytes;
+	Entry.LastUsed = ++UseCounter;
+	UsedBytes += Bytes;
+
+	EvictToBudget();
+}
+
+void FReferenceOrbitCache::SetBudgetBytes(SIZE_T InBudgetBytes)
+{
+	BudgetBytes = InBudgetBytes;
+	EvictToBudget();
+}
+
+void FReferenceOrbitCache::Empty()
+{
+	Entries.Empty();
+	UsedBytes = 0;
+}
+
+FFractalOrbitCacheStats FReferenceOrbitCache::GetStats() const
+{
+	FFractalOrbitCacheStats Stats;
+	Stats.Hits = Hits;
+	Stats.Misses = Misses;
+	Stats.Evictions = Evictions;
+	Stats.NumEntries = Entries.Num();
+	Stats.UsedBytes = static_cast<int64>(UsedBytes);
+	Stats.BudgetBytes = static_cast<int64>(BudgetBytes);
+	return Stats;
+}
+
+void FReferenceOrbitCache::EvictToBudget()
+{
+	// Entry counts stay small (tens), so a linear scan for the oldest entry is cheaper than maintaining a list
+	while (UsedBytes > BudgetBytes && Entries.Num() > 0)
+	{
+		const FOrbitCacheKey* OldestKey = nullptr;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<FOrbitCacheKey, FEntry>& Pair : Entries)
+		{
+			if (Pair.Value.LastUsed < OldestUse)
+			{
+				OldestUse = Pair.Value.LastUsed;
+				OldestKey = &Pair.Key;
+			}
+		}
+
+		const FOrbitCacheKey EvictedKey = *OldestKey;
+		UsedBytes -= Entries.FindChecked(EvictedKey).Bytes;
+		Entries.Remove(EvictedKey);
+		++Evictions;
+	}
+}
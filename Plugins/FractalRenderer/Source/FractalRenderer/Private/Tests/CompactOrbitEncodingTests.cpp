@@ -0,0 +1,71 @@
+#include "Tests/FractalTestHelpers.h"
+#include "CompactOrbitEncoding.h"
+#include "MandelbulbOrbitGenerator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Every decoded point of the compact encoding must stay within its GetErrorBound of the double orbit,
+ * and distances estimated from the decoded orbit at escaping samples around each reference must stay
+ * within MaxRelativeDistanceError of those from the double orbit.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFractalCompactEncodingTest, "Fractal.Orbit.CompactEncodingAccuracy", FractalTests::Flags)
+
+bool FFractalCompactEncodingTest::RunTest(const FString& Parameters)
+{
+	// Long enough to span many blocks and the far-field magnitudes the step has to follow
+	constexpr int32 MaxIterations = 10000;
+	constexpr int32 NumOrbits = 4;
+	constexpr double Power = 8.0;
+	constexpr double BailoutRadius = 2.0;
+	constexpr int32 NumDistanceSamples = 64;
+
+	const FMandelbulbOrbitGenerator Generator;
+	FRandomStream Stream(FractalTests::Seed);
+
+	int64 NumPoints = 0;
+	int64 NumViolations = 0;
+	int64 NumDistances = 0;
+	int64 NumDistanceViolations = 0;
+	double MaxDistanceError = 0.0;
+
+	// Centers near the origin stay bounded, which is where long orbits come from
+	for (const FVector3d& Center : FractalTests::MakeRandomCenters(Stream, NumOrbits, 0.6))
+	{
+		const FReferenceOrbit Orbit = Generator.GenerateOrbit(Center, Power, MaxIterations, BailoutRadius);
+		FCompactOrbitEncoding Encoding;
+		Encoding.Encode(Orbit);
+
+		for (int32 Index = 0; Index < Encoding.Num(); ++Index)
+		{
+			const double Error = (FVector3d(Encoding.DecodePosition(Index)) - Orbit.GetPosition(Index)).Length();
+			NumViolations += Error > Encoding.GetErrorBound(Index) ? 1 : 0;
+		}
+		NumPoints += Encoding.Num();
+
+		// Offsets from 1e-4 to 1e-1 in random directions, the range perturbation is used over
+		for (int32 SampleIndex = 0; SampleIndex < NumDistanceSamples; ++SampleIndex)
+		{
+			const FVector3d Position = Orbit.ReferenceCenter + Stream.GetUnitVector() * FMath::Pow(10.0, Stream.FRandRange(-4.0, -1.0));
+			const TOptional<double> DistanceError = Encoding.GetRelativeDistanceError(Orbit, Position);
+			if (!DistanceError.IsSet())
+			{
+				continue;
+			}
+
+			MaxDistanceError = FMath::Max(MaxDistanceError, DistanceError.GetValue());
+			NumDistanceViolations += DistanceError.GetValue() > FCompactOrbitEncoding::MaxRelativeDistanceError ? 1 : 0;
+			++NumDistances;
+		}
+	}
+
+	TestTrue(TEXT("Encodes orbit points"), NumPoints > 0);
+	TestEqual(TEXT("Decoded points outside the encoding's error bound"), NumViolations, int64(0));
+	TestTrue(TEXT("Checks escaping distance samples"), NumDistances > 0);
+	TestEqual(FString::Printf(TEXT("Distance samples over the relative DE tolerance %.0e (max %.3e)"), FCompactOrbitEncoding::MaxRelativeDistanceError, MaxDistanceError),
+		NumDistanceViolations, int64(0));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,73 @@
+#include "Tests/FractalTestHelpers.h"
+#include "FractalCpuRenderer.h"
+#include "MandelbulbOrbitGenerator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Marching in ray packets must reproduce the scalar march of the default scene (the whole bulb from
+ * Fractal.CpuRender's headless camera). The two are not bit-identical: a packet group starts the series
+ * approximation from the bucket of its largest delta, never later than any of its lanes would, so its
+ * DE carries a slightly different series error and rays grazing the silhouette or hitting the step
+ * limit can end one step apart. Only those pixels may change, so the tolerance is a pixel count, not
+ * a color error.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFractalCpuRayPacketTest, "Fractal.CpuRender.RayPackets", FractalTests::Flags)
+
+bool FFractalCpuRayPacketTest::RunTest(const FString& Parameters)
+{
+	const FIntPoint Extent(160, 90);
+
+	// One 8-bit step; smaller differences are rounding in the shading, not a different march
+	constexpr float ColorTolerance = 1.0f / 255.0f;
+
+	// Silhouette and step-limited pixels are a small fraction of the frame; 0.1% allows a few of them
+	constexpr double MaxDifferingFraction = 1e-3;
+
+	const FFractalParameter FractalParameters;
+	const FMandelbulbOrbitGenerator Generator;
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> References;
+	References.Add(MakeShared<const FReferenceOrbit, ESPMode::ThreadSafe>(Generator.GenerateOrbit(
+		FVector3d(FractalParameters.Center.X, FractalParameters.Center.Y, 0.0), FractalParameters.FractalPower, FractalParameters.MaxIterations, FractalParameters.BailoutRadius)));
+
+	// The bulb spans about 1.2 fractal units around the origin, i.e. 1.2 / Zoom world units
+	const double FractalToWorld = 1.0 / FMath::Max(static_cast<double>(FractalParameters.Zoom), UE_DOUBLE_SMALL_NUMBER);
+	const FFractalCpuCamera Camera = FFractalCpuCamera::FromViewpoint(FVector3d(-3.0 * FractalToWorld, 0.0, 0.0), FRotator::ZeroRotator, 60.0, Extent);
+	const FFractalCpuRenderer Renderer(FractalParameters, MoveTemp(References));
+
+	FFractalCpuRenderSettings ScalarSettings;
+	ScalarSettings.bUseRayPackets = false;
+	FFractalCpuRenderSettings PacketSettings;
+	PacketSettings.bUseRayPackets = true;
+
+	const FFractalCpuImage ScalarImage = Renderer.Render(Camera, ScalarSettings);
+	const FFractalCpuImage PacketImage = Renderer.Render(Camera, PacketSettings);
+
+	TestFalse(TEXT("Scalar frame marched one ray at a time"), ScalarImage.bRayPackets);
+	if (!TestTrue(FString::Printf(TEXT("Power %.2f frame marched in ray packets"), FractalParameters.FractalPower), PacketImage.bRayPackets)
+		|| !TestEqual(TEXT("Packet frame pixel count"), PacketImage.Pixels.Num(), ScalarImage.Pixels.Num()))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Scalar frame hits the bulb"), ScalarImage.NumHits > 0);
+
+	int32 NumDiffering = 0;
+	float MaxDifference = 0.0f;
+	for (int32 Index = 0; Index < ScalarImage.Pixels.Num(); ++Index)
+	{
+		const FLinearColor& A = ScalarImage.Pixels[Index];
+		const FLinearColor& B = PacketImage.Pixels[Index];
+		const float Difference = FMath::Max(FMath::Max(FMath::Abs(A.R - B.R), FMath::Abs(A.G - B.G)), FMath::Max(FMath::Abs(A.B - B.B), FMath::Abs(A.A - B.A)));
+		NumDiffering += Difference > ColorTolerance ? 1 : 0;
+		MaxDifference = FMath::Max(MaxDifference, Difference);
+	}
+
+	const int64 MaxDiffering = static_cast<int64>(MaxDifferingFraction * ScalarImage.GetNumPixels());
+	TestTrue(FString::Printf(TEXT("%d of %lld pixels differ by more than 1/255 (max %.4f), at most %lld allowed"),
+		NumDiffering, ScalarImage.GetNumPixels(), MaxDifference, MaxDiffering),
+		NumDiffering <= MaxDiffering);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "MandelbulbMath.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FractalTests
+{
+	// The tests need no world or RHI, so they run in every context, including -nullrhi commandlets on CI
+	constexpr EAutomationTestFlags Flags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	// Fixed seed, so a failure reproduces with the same reference centers and offsets
+	constexpr int32 Seed = 1337;
+
+	// Reference centers spread uniformly over [-Extent, Extent] on each axis
+	inline TArray<FVector3d> MakeRandomCenters(FRandomStream& Stream, int32 Num, double Extent)
+	{
+		TArray<FVector3d> Centers;
+		Centers.Reserve(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Centers.Add(FVector3d(Stream.FRandRange(-Extent, Extent), Stream.FRandRange(-Extent, Extent), Stream.FRandRange(-Extent, Extent)));
+		}
+		return Centers;
+	}
+
+	// Calls Test(Power) for every integer power with a polynomial specialization
+	template <typename TestType>
+	void ForEachPolynomialPower(TestType&& Test)
+	{
+		for (int32 Power = MandelbulbMath::MinPolynomialPower; Power <= MandelbulbMath::MaxPolynomialPower; ++Power)
+		{
+			Test(static_cast<double>(Power));
+		}
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,143 @@
+#include "Tests/FractalTestHelpers.h"
+#include "MandelbulbOrbitGenerator.h"
+#include "MandelbulbMath.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * The compile-time polynomial power map must agree with the trig implementation on every point of
+ * random orbits, for every power it specializes. Orbits are chaotic, so single steps are compared.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFractalPowerMapTest, "Fractal.Orbit.PowerMap", FractalTests::Flags)
+
+bool FFractalPowerMapTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 MaxIterations = 1000;
+	constexpr int32 NumOrbits = 16;
+	constexpr double BailoutRadius = 2.0;
+
+	// The trig path loses a few ulps through acos/atan2 near the poles; anything larger is a bug
+	constexpr double Tolerance = 1e-9;
+
+	const FMandelbulbOrbitGenerator Generator;
+	FractalTests::ForEachPolynomialPower([&](double Power)
+	{
+		FRandomStream Stream(FractalTests::Seed);
+		double MaxRelativeError = 0.0;
+		int64 NumPoints = 0;
+		for (const FVector3d& Center : FractalTests::MakeRandomCenters(Stream, NumOrbits, 1.2))
+		{
+			const FReferenceOrbit Orbit = Generator.GenerateOrbit(Center, Power, MaxIterations, BailoutRadius);
+			for (int32 Index = 0; Index < Orbit.GetLength(); ++Index)
+			{
+				const FVector3d Position = Orbit.GetPosition(Index);
+				const FVector3d Trig = MandelbulbMath::TrigPowerMap(Position, Power);
+				const FVector3d Polynomial = MandelbulbMath::DispatchPower(Power, [&]<int32 P>() { return MandelbulbMath::PowerMap<P>(Position, Power); });
+				MaxRelativeError = FMath::Max(MaxRelativeError, (Trig - Polynomial).Length() / FMath::Max(Trig.Length(), 1e-300));
+			}
+			NumPoints += Orbit.GetLength();
+		}
+
+		TestTrue(FString::Printf(TEXT("Power %.0f visits orbit points"), Power), NumPoints > 0);
+		TestTrue(FString::Printf(TEXT("Power %.0f max relative single-step deviation %.3e within %.0e"), Power, MaxRelativeError, Tolerance),
+			MaxRelativeError <= Tolerance);
+	});
+
+	return true;
+}
+
+/**
+ * The series approximation table must match direct double iteration: for offsets in each radius bucket,
+ * z_{S_k}(C_0 + delta) - Z_{S_k} equals A_{S_k} * delta within the table's tolerance. Checked on fresh
+ * orbits, after ExtendOrbit truncates them to a quarter (the table is clamped, never past the end), and
+ * after extending them back, which must restore every bucket's original skip.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFractalSeriesApproximationTest, "Fractal.Orbit.SeriesApproximation", FractalTests::Flags)
+
+bool FFractalSeriesApproximationTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 MaxIterations = 1000;
+	constexpr int32 NumOrbits = 16;
+	constexpr double BailoutRadius = 2.0;
+
+	// Past this bucket the direct difference is dominated by double cancellation, not the series
+	constexpr int32 MaxTestedBucket = 24;
+	constexpr int32 SamplesPerBucket = 8;
+
+	// The table bounds the second-order term on its probe directions; other directions and the float coefficients get slack
+	constexpr double Tolerance = 10.0 * FOrbitSeriesApproximation::DefaultTolerance;
+
+	const FMandelbulbOrbitGenerator Generator;
+	FractalTests::ForEachPolynomialPower([&](double Power)
+	{
+		FRandomStream Stream(FractalTests::Seed);
+		double MaxRelativeError = 0.0;
+		int64 NumSamples = 0;
+		int64 NumSkipsPastEnd = 0;
+		int32 NumChangedSkips = 0;
+		const auto CheckTable = [&](const FReferenceOrbit& Orbit)
+		{
+			for (int32 Bucket = 0; Bucket <= MaxTestedBucket; ++Bucket)
+			{
+				for (int32 Sample = 0; Sample < SamplesPerBucket; ++Sample)
+				{
+					// Radii near the top of the bucket can round into the next larger one; test whichever they land in
+					const double Radius = FMath::Exp2(-static_cast<double>(Bucket)) * Stream.FRandRange(0.51, 1.0);
+					const FVector3d Delta = Stream.GetUnitVector() * Radius;
+					const int32 SampleBucket = FOrbitSeriesApproximation::GetBucket(Delta.Length());
+					const int32 SkipIteration = Orbit.SeriesApproximation.GetSkipIteration(SampleBucket);
+					if (SkipIteration >= Orbit.GetLength())
+					{
+						++NumSkipsPastEnd;
+						continue;
+					}
+					if (SkipIteration == 0)
+					{
+						continue;
+					}
+
+					FVector3d Z = FVector3d::ZeroVector;
+					for (int32 Iteration = 0; Iteration < SkipIteration; ++Iteration)
+					{
+						Z = FMandelbulbOrbitGenerator::MandelbulbIteration(Z, Orbit.ReferenceCenter + Delta, Power);
+					}
+
+					const FVector3d Direct = Z - Orbit.GetPosition(SkipIteration);
+					const FVector3d Series = Orbit.SeriesApproximation.Evaluate(SampleBucket, Delta);
+					MaxRelativeError = FMath::Max(MaxRelativeError, (Direct - Series).Length() / FMath::Max(Direct.Length(), 1e-300));
+					++NumSamples;
+				}
+			}
+		};
+
+		for (const FVector3d& Center : FractalTests::MakeRandomCenters(Stream, NumOrbits, 1.2))
+		{
+			const FReferenceOrbit Orbit = Generator.GenerateOrbit(Center, Power, MaxIterations, BailoutRadius);
+			if (!TestTrue(FString::Printf(TEXT("Power %.0f orbit has a series table"), Power), Orbit.SeriesApproximation.IsValid()))
+			{
+				continue;
+			}
+			CheckTable(Orbit);
+
+			FReferenceOrbit Truncated = Orbit;
+			Generator.ExtendOrbit(Truncated, MaxIterations / 4);
+			CheckTable(Truncated);
+
+			Generator.ExtendOrbit(Truncated, MaxIterations);
+			for (int32 Bucket = 0; Bucket < FOrbitSeriesApproximation::NumRadiusBuckets; ++Bucket)
+			{
+				NumChangedSkips += Truncated.SeriesApproximation.GetSkipIteration(Bucket) != Orbit.SeriesApproximation.GetSkipIteration(Bucket) ? 1 : 0;
+			}
+		}
+
+		TestTrue(FString::Printf(TEXT("Power %.0f checks samples"), Power), NumSamples > 0);
+		TestEqual(FString::Printf(TEXT("Power %.0f skips past the orbit end"), Power), NumSkipsPastEnd, int64(0));
+		TestEqual(FString::Printf(TEXT("Power %.0f buckets whose skip changed after truncating and extending back"), Power), NumChangedSkips, 0);
+		TestTrue(FString::Printf(TEXT("Power %.0f max relative deviation from direct iteration %.3e within %.0e"), Power, MaxRelativeError, Tolerance),
+			MaxRelativeError <= Tolerance);
+	});
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FReferenceOrbit;
+
+/**
+ * Compact GPU encoding of a reference orbit, 12.25 bytes per point instead of the 24 of the float3
+ * views (and the 32 of the former float4 textures).
+ *
+ * Positions are delta-quantized per block of PointsPerBlock consecutive points: the block stores a
+ * float origin (the center of its bounding box) and a step, each point three signed 21-bit multiples
+ * of the step packed into two uints. The derivative channel keeps only the scale p*|Z_n|^(p-1);
+ * |Z_n| is recomputed from the decoded position, and dr is only read at series skip iterations, where
+ * the series table carries it.
+ *
+ * Decoding follows the shader (origin + q * step in float), so |decoded - Z_n| stays within half a
+ * step plus float rounding of the result; GetErrorBound reports that bound per point.
+ */
+struct FRACTALRENDERER_API FCompactOrbitEncoding
+{
+	static constexpr int32 PointsPerBlock = 64;
+	static constexpr int32 BitsPerComponent = 21;
+	static constexpr int32 MaxQuantizedMagnitude = (1 << (BitsPerComponent - 1)) - 1;
+
+	/** Bytes per point including the amortized block header. */
+	static constexpr double BytesPerPoint = sizeof(FUintVector2) + sizeof(float) + double(sizeof(FVector4f)) / PointsPerBlock;
+
+	TArray<FVector4f> Blocks;          // (origin, step) per block
+	TArray<FUintVector2> Positions;    // Quantized offsets from the block origin, padded to whole blocks
+	TArray<float> Scales;              // p*|Z_n|^(p-1) per point, padded like Positions
+
+	/** Encode the orbit's active length, replacing any previous contents. */
+	void Encode(const FReferenceOrbit& Orbit);
+
+	/** Points encoded, without the padding. */
+	int32 Num() const { return NumPoints; }
+
+	/** Z_n as the shader decodes it. */
+	FVector3f DecodePosition(int32 Index) const;
+
+	/** Largest |DecodePosition(Index) - Z_n| the encoding allows. */
+	double GetErrorBound(int32 Index) const;
+
+	/** Largest relative DE deviation from the double orbit the encoding may cause at a sample. */
+	static constexpr double MaxRelativeDistanceError = 1e-3;
+
+	/**
+	 * Relative difference between the distances the shader's perturbation loop (without series skip or
+	 * convergence exit) estimates at Position from this encoding and from the double Orbit it encodes;
+	 * 1 if only the encoding keeps the sample bounded. Unset when the double orbit keeps it bounded,
+	 * where the DE carries no surface information.
+	 */
+	TOptional<double> GetRelativeDistanceError(const FReferenceOrbit& Orbit, const FVector3d& Position) const;
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const { return Blocks.GetAllocatedSize() + Positions.GetAllocatedSize() + Scales.GetAllocatedSize(); }
+
+private:
+	int32 NumPoints = 0;
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Error-free transformations break if fast-math reassociates them or a*b+c is contracted to an FMA
+#if defined(_MSC_VER) || defined(__clang__)
+#pragma float_control(precise, on, push)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+/**
+ * Double-double real: an unevaluated sum Hi + Lo of two doubles with |Lo| <= ulp(Hi) / 2,
+ * giving ~106 bits of mantissa (about 32 decimal digits) with the exponent range of double.
+ *
+ * Arithmetic uses error-free transformations (Knuth TwoSum, Dekker TwoProd with Veltkamp
+ * splitting) so it does not depend on hardware FMA being enabled for the target.
+ * Used as the extended-precision RealType for reference orbit generation.
+ */
+struct FDoubleDouble
+{
+	double Hi;
+	double Lo;
+
+	FORCEINLINE FDoubleDouble() : Hi(0.0), Lo(0.0) {}
+	FORCEINLINE FDoubleDouble(double InValue) : Hi(InValue), Lo(0.0) {}
+	FORCEINLINE FDoubleDouble(double InHi, double InLo) : Hi(InHi), Lo(InLo) {}
+
+	/** Nearest double to this value. */
+	FORCEINLINE double ToDouble() const { return Hi + Lo; }
+
+	/** s + e == a + b exactly. */
+	static FORCEINLINE FDoubleDouble TwoSum(double A, double B)
+	{
+		const double S = A + B;
+		const double V = S - A;
+		const double E = (A - (S - V)) + (B - V);
+		return FDoubleDouble(S, E);
+	}
+
+	/** s + e == a + b exactly, requires |a| >= |b|. */
+	static FORCEINLINE FDoubleDouble QuickTwoSum(double A, double B)
+	{
+		const double S = A + B;
+		const double E = B - (S - A);
+		return FDoubleDouble(S, E);
+	}
+
+	/** p + e == a * b exactly (Dekker). */
+	static FORCEINLINE FDoubleDouble TwoProd(double A, double B)
+	{
+		// Veltkamp split into 26-bit halves: 2^27 + 1
+		constexpr double Splitter = 134217729.0;
+
+		const double P = A * B;
+
+		const double TA = Splitter * A;
+		const double AHi = TA - (TA - A);
+		const double ALo = A - AHi;
+
+		const double TB = Splitter * B;
+		const double BHi = TB - (TB - B);
+		const double BLo = B - BHi;
+
+		const double E = ((AHi * BHi - P) + AHi * BLo + ALo * BHi) + ALo * BLo;
+		return FDoubleDouble(P, E);
+	}
+
+	FORCEINLINE FDoubleDouble operator-() const { return FDoubleDouble(-Hi, -Lo); }
+
+	FORCEINLINE friend FDoubleDouble operator+(const FDoubleDouble& A, const FDoubleDouble& B)
+	{
+		// Accurate (IEEE-style) addition: both the high and low parts are summed error-free
+		FDoubleDouble S = TwoSum(A.Hi, B.Hi);
+		const FDoubleDouble T = TwoSum(A.Lo, B.Lo);
+		S.Lo += T.Hi;
+		S = QuickTwoSum(S.Hi, S.Lo);
+		S.Lo += T.Lo;
+		return QuickTwoSum(S.Hi, S.Lo);
+	}
+
+	FORCEINLINE friend FDoubleDouble operator-(const FDoubleDouble& A, const FDoubleDouble& B)
+	{
+		return A + (-B);
+	}
+
+	FORCEINLINE friend FDoubleDouble operator*(const FDoubleDouble& A, const FDoubleDouble& B)
+	{
+		FDoubleDouble P = TwoProd(A.Hi, B.Hi);
+		P.Lo += A.Hi * B.Lo + A.Lo * B.Hi;
+		return QuickTwoSum(P.Hi, P.Lo);
+	}
+
+	FORCEINLINE friend FDoubleDouble operator/(const FDoubleDouble& A, const FDoubleDouble& B)
+	{
+		// Long division: first quotient digit, correct with the remainder
+		const double Q1 = A.Hi / B.Hi;
+		const FDoubleDouble R = A - B * FDoubleDouble(Q1);
+		const double Q2 = R.Hi / B.Hi;
+		const FDoubleDouble R2 = R - B * FDoubleDouble(Q2);
+		const double Q3 = R2.Hi / B.Hi;
+
+		FDoubleDouble Q = QuickTwoSum(Q1, Q2);
+		return Q + FDoubleDouble(Q3);
+	}
+
+	FORCEINLINE FDoubleDouble& operator+=(const FDoubleDouble& B) { return *this = *this + B; }
+	FORCEINLINE FDoubleDouble& operator-=(const FDoubleDouble& B) { return *this = *this - B; }
+	FORCEINLINE FDoubleDouble& operator*=(const FDoubleDouble& B) { return *this = *this * B; }
+
+	FORCEINLINE friend bool operator<(const FDoubleDouble& A, const FDoubleDouble& B) { return A.Hi < B.Hi || (A.Hi == B.Hi && A.Lo < B.Lo); }
+	FORCEINLINE friend bool operator>(const FDoubleDouble& A, const FDoubleDouble& B) { return B < A; }
+	FORCEINLINE friend bool operator<(const FDoubleDouble& A, double B) { return A < FDoubleDouble(B); }
+	FORCEINLINE friend bool operator>(const FDoubleDouble& A, double B) { return A > FDoubleDouble(B); }
+
+	// Sqrt and ToDouble are hidden friends: MandelbulbMath's generic code finds them through the argument
+	// type, and they add no global overloads that could shadow or collide with anyone else's
+
+	/** Square root by one Newton step on the double estimate (Karp's trick), accurate to ~1 ulp of double-double. */
+	FORCEINLINE friend FDoubleDouble Sqrt(const FDoubleDouble& A)
+	{
+		if (A.Hi <= 0.0)
+		{
+			return FDoubleDouble(0.0);
+		}
+
+		const double X = 1.0 / FMath::Sqrt(A.Hi);
+		const double AX = A.Hi * X;
+		const FDoubleDouble Residual = A - TwoProd(AX, AX);
+		return TwoSum(AX, Residual.Hi * (X * 0.5));
+	}
+
+	FORCEINLINE friend double ToDouble(const FDoubleDouble& A) { return A.ToDouble(); }
+};
+
+#if defined(_MSC_VER) || defined(__clang__)
+#pragma float_control(pop)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
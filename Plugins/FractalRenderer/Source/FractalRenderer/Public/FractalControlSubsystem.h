@@ -2,19 +2,37 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
 #include "FractalParameter.h"
 #include "MandelbulbOrbitGenerator.h"
+#include "ReferenceOrbitCache.h"
+#include "FractalQualityGovernor.h"
+#include "FractalStats.h"
 #include "FractalControlSubsystem.generated.h"
 
 // Forward declarations
 class FMandelbulbOrbitGenerator;
+struct FOrbitGenerationJobState;
 
 /**
  * Game Instance Subsystem for controlling fractal rendering parameters
  * Access from Blueprint or C++ to control the Scene View Extension
+ *
+ * Reference orbits are generated on a background task. The last published orbit keeps
+ * rendering until a newer one completes; superseded in-flight jobs are cancelled.
+ *
+ * A small grid of reference orbits is spread over the frustum being marched, so every sample has a
+ * reference nearby; the shader perturbs each sample from the closest one.
+ *
+ * Pixels where perturbation breaks down are read back from the renderer; clusters of them get
+ * secondary reference orbits, which the shader retries glitched samples against.
+ *
+ * A quality governor reads the measured GPU time of the fractal passes and scales the marched resolution,
+ * then the ray-step and DE budgets, sent to the renderer to hold Fractal.Governor.TargetMs. The configured parameters are left
+ * untouched, so governed changes never regenerate the reference orbit.
  */
 UCLASS()
-class FRACTALRENDERER_API UFractalControlSubsystem : public UGameInstanceSubsystem
+class FRACTALRENDERER_API UFractalControlSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 
@@ -22,6 +40,12 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
+	// FTickableGameObject interface (publishes completed background orbits)
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
 	// Set all fractal parameters
 	UFUNCTION(BlueprintCallable, Category = "Fractal")
 	void SetFractalParameters(const FFractalParameter& InParams);
@@ -36,6 +60,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Fractal|Controls")
 	void SetZoom(float InZoom);
 
+	UFUNCTION(BlueprintCallable, Category = "Fractal|Controls")
+	void SetScreenPercentage(float InScreenPercentage);
+
 	UFUNCTION(BlueprintCallable, Category = "Fractal|Controls")
 	void SetMaxRaySteps(int32 InMaxRaySteps);
 
@@ -57,36 +84,122 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Fractal|Controls")
 	void SetFractalPower(float InFractalPower);
 
+	UFUNCTION(BlueprintCallable, Category = "Fractal|Controls")
+	void SetOrbitPrecision(EFractalOrbitPrecision InOrbitPrecision);
+
 	// Get current fractal parameters
 	UFUNCTION(BlueprintPure, Category = "Fractal")
 	const FFractalParameter& GetFractalParameters() const { return FractalParameters; }
 
+	// Parameters the renderer currently receives: the configured ones with the governor's budgets applied
+	UFUNCTION(BlueprintPure, Category = "Fractal")
+	FFractalParameter GetRenderedParameters() const { return QualityGovernor.Apply(FractalParameters); }
+
+	// Fraction of the configured ray-step and iteration budgets the governor currently allows
+	UFUNCTION(BlueprintPure, Category = "Fractal|Governor")
+	float GetGovernorQuality() const { return QualityGovernor.GetQuality(); }
+
 	// Regenerate reference orbit (for testing/debugging)
 	UFUNCTION(BlueprintCallable, Category = "Fractal|Orbit")
 	void RegenerateOrbit();
 
-	// Get current reference orbit data (read-only)
-	const FReferenceOrbit& GetReferenceOrbit() const { return CurrentOrbit; }
+	// Get the most recently published reference orbit (read-only)
+	const FReferenceOrbit& GetReferenceOrbit() const;
+
+	// True while a newer orbit than the published one is still being generated
+	bool IsOrbitGenerationPending() const { return RequestedOrbitVersion != PublishedOrbitVersion; }
 
 	// Check if orbit needs regeneration based on parameter changes
 	bool ShouldRegenerateOrbit(const FFractalParameter& NewParams) const;
 
+	// Hit/miss counters and occupancy of the reference orbit cache
+	UFUNCTION(BlueprintPure, Category = "Fractal|Orbit")
+	FFractalOrbitCacheStats GetOrbitCacheStats() const;
+
+	// Grid reference orbits currently spread over the marched frustum
+	UFUNCTION(BlueprintPure, Category = "Fractal|Orbit")
+	int32 GetNumGridReferences() const { return GridOrbits.Num(); }
+
+	// Secondary reference orbits currently placed on glitch clusters of the published orbit
+	UFUNCTION(BlueprintPure, Category = "Fractal|Orbit")
+	int32 GetNumSecondaryReferences() const { return SecondaryOrbits.Num(); }
+
+	// Published primary orbit followed by the grid and secondary orbits, in the order the renderer binds them
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> GetReferenceOrbits() const;
+
+	// Live timings and counters of the whole pipeline, from orbit generation to the GPU (same numbers as stat Fractal)
+	const FFractalPipelineStats& GetPipelineStats() const { return PipelineStats; }
+
 private:
 	UPROPERTY()
 	FFractalParameter FractalParameters;
 
-	// High-precision orbit generator
-	TUniquePtr<FMandelbulbOrbitGenerator> OrbitGenerator;
+	// High-precision orbit generator (shared with in-flight background jobs)
+	TSharedPtr<FMandelbulbOrbitGenerator, ESPMode::ThreadSafe> OrbitGenerator;
+
+	// Last good reference orbit, published to the view extension
+	TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe> CurrentOrbit;
+
+	// Cache key of CurrentOrbit, used to detect iteration-only changes that can extend it
+	FOrbitCacheKey CurrentOrbitKey;
 
-	// Current reference orbit data
-	FReferenceOrbit CurrentOrbit;
+	// Recently used orbits keyed by quantized center/power/bailout/iterations (Fractal.OrbitCache.BudgetMB)
+	FReferenceOrbitCache OrbitCache;
 
-	// Last parameters used to generate orbit (for change detection)
+	// Hand-off slot shared with background jobs (latest request, completed result)
+	TSharedPtr<FOrbitGenerationJobState, ESPMode::ThreadSafe> OrbitJobState;
+
+	// Version of the most recently requested orbit and of the one currently published
+	uint64 RequestedOrbitVersion = 0;
+	uint64 PublishedOrbitVersion = 0;
+
+	// Grid reference orbits for the published orbit and the centers they were requested at (Fractal.ReferenceGrid.*)
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> GridOrbits;
+	TArray<FVector3d> GridCenters;
+
+	// Whether a grid orbit job for the published orbit has not reported back yet
+	bool bGridJobInFlight = false;
+
+	// Secondary reference orbits for the published orbit, placed on glitch clusters reported by the renderer
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> SecondaryOrbits;
+
+	// Whether a secondary orbit job for the published orbit has not reported back yet
+	bool bSecondaryJobInFlight = false;
+
+	// Last parameters used to request an orbit (for change detection)
 	FFractalParameter LastOrbitParams;
 
+	// Scales the budgets sent to the renderer to hold the target GPU time (Fractal.Governor.*)
+	FFractalQualityGovernor QualityGovernor;
+
+	// Pipeline numbers for overlays, refreshed every tick
+	FFractalPipelineStats PipelineStats;
+
+	// Orbit requests that missed the cache since RegenerationWindowStart, folded into PipelineStats once a second
+	int32 NumRegenerationsInWindow = 0;
+	double RegenerationWindowStart = 0.0;
+
 	// Update the scene view extension with current parameters
 	void UpdateSceneViewExtension();
 
-	// Generate new reference orbit based on current parameters
+	// Feed the latest measured GPU time to the governor and republish the parameters if it changed the budgets
+	void UpdateQualityGovernor();
+
+	// Refresh PipelineStats and the game-thread stats from the view extension's latest frame
+	void UpdatePipelineStats();
+
+	// Publish a cached orbit for the current parameters, or kick off background generation of a new one
 	void GenerateReferenceOrbit();
+
+	// Collect finished grid orbits and regenerate the grid once the camera has moved away from it
+	void UpdateReferenceGrid();
+
+	// Collect finished secondary orbits and launch new ones for glitch clusters in the latest report
+	void UpdateSecondaryReferences();
+
+	// Swap in a completed or cached orbit and push it to the view extension
+	void PublishReferenceOrbit(TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe> InOrbit, const FOrbitCacheKey& InKey, uint64 InVersion, bool bFromCache);
+
+	// Current orbit cache budget from Fractal.OrbitCache.BudgetMB
+	static SIZE_T GetOrbitCacheBudgetBytes();
 };
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FractalParameter.h"
+#include "MandelbulbOrbitGenerator.h"
+
+/**
+ * Camera of a CPU-rendered frame: the same inputs the GPU march reads from the scene view
+ * (inverse view and projection matrices, camera origin, marched extent and sub-pixel jitter).
+ */
+struct FRACTALRENDERER_API FFractalCpuCamera
+{
+	FMatrix ViewToWorld = FMatrix::Identity;        // Inverse view matrix
+	FMatrix ClipToView = FMatrix::Identity;         // Inverse projection matrix
+	FVector3d Origin = FVector3d::ZeroVector;       // World-space camera position
+	FIntPoint Extent = FIntPoint::ZeroValue;        // Pixels marched
+	FVector2D SampleJitter = FVector2D::ZeroVector; // Sub-pixel offset of every ray, in pixels
+
+	/** Camera from a view and a projection matrix as FViewMatrices stores them. */
+	static FFractalCpuCamera FromMatrices(const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix, FIntPoint InExtent);
+
+	/** Camera at Location facing Rotation with the engine's reversed-Z perspective projection. */
+	static FFractalCpuCamera FromViewpoint(const FVector3d& Location, const FRotator& Rotation, double HorizontalFovDegrees, FIntPoint InExtent);
+
+	/** World-space ray through a position in pixels, as the shader's GetCameraRay builds it. */
+	void GetRay(const FVector2D& PixelPosition, FVector3d& OutOrigin, FVector3d& OutDirection) const;
+
+	/** World-space radius one pixel covers at Distance along a ray (the march's hit threshold). */
+	double GetPixelWorldRadius(double Distance) const;
+};
+
+struct FFractalCpuRenderSettings
+{
+	int32 TileSize = 16;                    // Pixels per side of the tiles workers take from the scheduler
+	bool bUseSeriesApproximation = true;    // Skip iterations like the shader; off iterates every orbit point
+	bool bUseRayPackets = true;             // March FDouble4::NumLanes rays in lockstep (integer powers 2..8 only)
+	bool bSingleThreaded = false;           // Render all tiles on the calling thread (scaling baseline)
+};
+
+/**
+ * A CPU-rendered frame: fractal color with its coverage over the background in alpha, exactly what the
+ * GPU march writes before compositing, plus march counters and timings.
+ */
+struct FRACTALRENDERER_API FFractalCpuImage
+{
+	FIntPoint Extent = FIntPoint::ZeroValue;
+	TArray<FLinearColor> Pixels;
+
+	int64 NumSteps = 0;
+	int64 NumDEIterations = 0;
+	int32 NumHits = 0;
+	int32 NumDistanceMisses = 0;            // Rays that reached MaxRayDistance
+	int32 NumStepLimited = 0;               // Rays that ran out of MaxRaySteps
+	int32 NumGlitchedPixels = 0;            // Pixels with at least one glitched DE sample
+
+	bool bRayPackets = false;               // Whether the frame was marched in ray packets
+
+	double WallSeconds = 0.0;
+	double BusySeconds = 0.0;               // Time spent in tiles summed over all workers
+	int32 NumTiles = 0;
+	int32 NumThreads = 0;                   // Distinct threads that rendered tiles
+
+	int64 GetNumPixels() const { return static_cast<int64>(Extent.X) * Extent.Y; }
+
+	/** Throughput of the whole frame. */
+	double GetMegapixelsPerSecond() const { return WallSeconds > 0.0 ? GetNumPixels() * 1e-6 / WallSeconds : 0.0; }
+
+	/** Throughput of one busy core, independent of how many workers the scheduler had. */
+	double GetMegapixelsPerSecondPerCore() const { return BusySeconds > 0.0 ? GetNumPixels() * 1e-6 / BusySeconds : 0.0; }
+
+	/** Composite over a solid background and quantize to 8-bit sRGB, e.g. for saving. */
+	TArray<FColor> ToColors(const FLinearColor& Background = FLinearColor::Black) const;
+};
+
+/**
+ * Headless reference renderer for the Mandelbulb: a double-precision port of the shader's MarchFractal,
+ * MandelbulbPerturbationDE and ShadeFractal driven by the same FFractalParameter, camera matrices and
+ * reference orbits. It needs no RHI, so frames can be rendered and validated on machines without a GPU.
+ *
+ * Frame-to-frame accelerations (reprojected and cone-prepass start distances) are not ported: every ray
+ * is marched from the camera, which is what they converge to. Tiles are distributed with ParallelFor,
+ * one task per tile, so idle workers steal remaining tiles and expensive regions do not serialize.
+ *
+ * For integer powers rays are marched in packets of FDouble4::NumLanes, one per SIMD lane. A lane whose
+ * ray hits or misses takes the tile's next ray, so packets stay full until the tile runs out. Within a
+ * DE evaluation, lanes are grouped by their nearest reference and each group runs the perturbation loop
+ * in lockstep, with finished lanes masked.
+ */
+class FRACTALRENDERER_API FFractalCpuRenderer
+{
+public:
+	/** References compete on distance like the shader's rows; the first is the primary orbit. */
+	FFractalCpuRenderer(const FFractalParameter& InParameters, TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> InReferences);
+
+	FFractalCpuImage Render(const FFractalCpuCamera& Camera, const FFractalCpuRenderSettings& Settings = FFractalCpuRenderSettings()) const;
+
+private:
+	FFractalParameter Parameters;
+	TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>> References;
+};
@@ -3,6 +3,18 @@
 #include "CoreMinimal.h"
 #include "FractalParameter.generated.h"
 
+/** Real type used to evaluate the CPU reference orbit. */
+UENUM(BlueprintType)
+enum class EFractalOrbitPrecision : uint8
+{
+    /** Double until Zoom drops below the extended-precision threshold, then double-double. */
+    Auto,
+    /** IEEE double (~16 significant digits). */
+    Double,
+    /** Double-double (~32 significant digits), several times slower per iteration. */
+    DoubleDouble
+};
+
 USTRUCT(BlueprintType)
 struct FRACTALRENDERER_API FFractalParameter
 {
@@ -21,6 +33,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fractal|Viewport")
     float Zoom;
 
+    /** Percentage of the output resolution the fractal is marched at; lower values are upscaled into the output. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fractal|Viewport", meta = (ClampMin = "10", ClampMax = "100", UIMin = "25", UIMax = "100"))
+    float ScreenPercentage;
+
     /** Maximum number of distance-estimation steps performed per ray. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fractal|Ray March")
     int32 MaxRaySteps;
@@ -49,10 +65,15 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fractal|Formula")
     float FractalPower;
 
+    /** Precision of the CPU reference orbit; Auto switches to double-double for deep zooms. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fractal|Distance Estimation")
+    EFractalOrbitPrecision OrbitPrecision;
+
     FFractalParameter()
         : Center(FVector2D::ZeroVector)
         , bEnabled(true)
         , Zoom(0.00001f)
+        , ScreenPercentage(100.0f)
         , MaxRaySteps(150)
         , MaxRayDistance(1000000.0f)
         , MaxIterations(150)
@@ -60,6 +81,7 @@ public:
         , MinIterations(5)
         , ConvergenceFactor(0.01f)
         , FractalPower(8.0f)
+        , OrbitPrecision(EFractalOrbitPrecision::Auto)
     {
     }
 };
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FractalParameter.h"
+
+/** Controller tuning, read from the Fractal.Governor.* console variables each update. */
+struct FFractalQualityGovernorSettings
+{
+	float TargetGpuMs = 10.0f;      // GPU time of the fractal passes to hold
+	float Hysteresis = 0.15f;       // Relative band around the target in which the budgets are left alone
+	float MinQuality = 0.25f;       // Lowest fraction of the configured budgets the governor may go down to
+	float MinResolution = 0.5f;     // Lowest fraction of the configured screen percentage, per axis
+	float RecoveryStep = 0.05f;     // Quality regained per decision while under the band
+	int32 CooldownSamples = 10;     // Samples after a change before the next decision, to let its timings arrive
+};
+
+/**
+ * Frame-time driven quality level for the ray-march and DE budgets, owned by the game thread.
+ *
+ * The quality level is the fraction of the configured GPU cost to spend, which scales with the marched
+ * pixels times the per-pixel budgets. Resolution is traded first, down to MinResolution per axis, so the
+ * step and iteration budgets only shrink once the resolution has bottomed out.
+ *
+ * Each GPU time sample of the fractal passes feeds a smoothed estimate. Above the hysteresis band the
+ * quality drops in proportion to the overshoot; below it, it recovers in small steps. Decisions wait a
+ * cooldown after every change, since timings arrive a few frames late. The quality only scales the
+ * configured values down (Apply), so the reference orbit, built for the configured iteration count,
+ * never has to be regenerated.
+ */
+class FRACTALRENDERER_API FFractalQualityGovernor
+{
+public:
+	/** Feed one GPU time sample in milliseconds; returns true when the quality level changed. */
+	bool Update(float GpuMs, const FFractalQualityGovernorSettings& Settings);
+
+	/** The configured parameters with ScreenPercentage, MaxRaySteps, MaxIterations, MinIterations and ConvergenceFactor scaled to the quality level. */
+	FFractalParameter Apply(const FFractalParameter& InParams) const;
+
+	/** Back to full quality, forgetting the timing history. Returns true if the quality level changed. */
+	bool Reset();
+
+	/** Fraction of the configured GPU cost currently allowed, in [MinQuality * MinResolution^2, 1]. */
+	float GetQuality() const { return Quality; }
+
+	/** Fraction of the configured screen percentage in use, per axis. */
+	float GetResolutionScale() const { return FMath::Sqrt(FMath::Max(Quality, FMath::Square(MinResolution))); }
+
+	/** Fraction of the configured step and iteration budgets in use. */
+	float GetBudgetScale() const { return Quality / FMath::Square(GetResolutionScale()); }
+
+	/** Smoothed GPU time the last decision was based on, 0 before the first sample. */
+	float GetSmoothedGpuMs() const { return SmoothedGpuMs; }
+
+private:
+	float Quality = 1.0f;
+	float SmoothedGpuMs = 0.0f;
+	float MinResolution = 1.0f;         // From the settings of the last update
+	int32 NumSamples = 0;               // Samples since the last change
+};
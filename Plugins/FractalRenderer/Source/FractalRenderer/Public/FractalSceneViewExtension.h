@@ -4,15 +4,111 @@
 #include "SceneViewExtension.h"
 #include "ScreenPass.h"
 #include "PostProcess/PostProcessMaterialInputs.h"
+#include "RHIGPUReadback.h"
+#include "Containers/TripleBuffer.h"
 #include "FractalParameter.h"
 #include "MandelbulbOrbitGenerator.h"
+#include "CompactOrbitEncoding.h"
 
 // Forward declarations
 class UFractalControlSubsystem;
 
+/** Glitched pixels reported by the fractal pass, read back from the GPU a few frames after rendering. */
+struct FFractalGlitchReport
+{
+	uint64 OrbitVersion = 0;        // Primary orbit the frame was rendered with
+	int32 NumReferences = 0;        // Orbit rows (primary, grid and secondaries) bound for that frame
+	uint32 NumGlitchedPixels = 0;   // Every glitched pixel, including those past the sample capacity
+	TArray<FVector3f> Samples;      // Fractal-space position where each recorded pixel first glitched
+};
+
+/** March counters of one rendered frame, read back from the GPU a few frames after rendering. */
+struct FFractalMarchStats
+{
+	uint32 NumPixels = 0;
+	uint64 MarchSteps = 0;          // Full-resolution DE steps
+	uint64 ConeStepsSaved = 0;      // Prepass steps of the tiles whose distance pixels started from, an estimate of steps skipped
+	uint32 ConePrepassSteps = 0;    // Steps the prepass itself marched
+	uint32 NumReprojectedPixels = 0; // Pixels that started from the reprojected history instead
+
+	float GetStepsPerPixel() const { return NumPixels > 0 ? static_cast<float>(MarchSteps) / NumPixels : 0.0f; }
+	float GetConeStepsSavedPerPixel() const { return NumPixels > 0 ? static_cast<float>(ConeStepsSaved) / NumPixels : 0.0f; }
+};
+
+/** Per-pixel march cost of one rendered frame, reduced to histograms on the GPU and read back a few frames later. */
+struct FFractalMarchHistogram
+{
+	int32 MaxRaySteps = 0;                  // Budgets the frame was marched with; they set the bucket ranges
+	int32 MaxIterations = 0;
+	TArray<uint32> StepBuckets;             // Pixels per step count, linear over [0, MaxRaySteps]
+	TArray<uint32> IterationBuckets;        // Pixels per DE iteration count, on log2(1 + iterations) up to MaxRaySteps * MaxIterations
+	uint32 NumPixels = 0;
+	uint32 NumHits = 0;
+	uint32 NumDistanceMisses = 0;           // Rays that passed MaxRayDistance without a hit
+	uint32 NumStepLimited = 0;              // Rays that ran out of MaxRaySteps first
+	uint64 TotalSteps = 0;
+	uint64 TotalIterations = 0;
+
+	float GetStepsPerPixel() const { return NumPixels > 0 ? static_cast<float>(TotalSteps) / NumPixels : 0.0f; }
+	float GetIterationsPerPixel() const { return NumPixels > 0 ? static_cast<float>(TotalIterations) / NumPixels : 0.0f; }
+
+	// Step or DE iteration count below which Fraction of the pixels lie, interpolated within its bucket
+	float GetStepPercentile(float Fraction) const;
+	float GetIterationPercentile(float Fraction) const;
+};
+
+/** Render thread cost of the newest rendered fractal view, and the newest measured GPU time. */
+struct FFractalRenderThreadStats
+{
+	float RenderThreadMs = 0.0f;            // RenderFractal_RenderThread, graph setup only
+	float LockWaitMs = 0.0f;                // Part of it spent waiting on locks shared with the game thread
+	uint32 UploadBytes = 0;                 // Orbit bytes uploaded for that view
+	float GpuMs = 0.0f;                     // Fractal passes of the newest frame whose timestamps came back
+};
+
+/** World-space camera frustum of the most recently rendered fractal view. */
+struct FFractalViewFrustum
+{
+	FVector3d Origin = FVector3d::ZeroVector;
+	FVector3d Forward = FVector3d::ForwardVector;
+	FVector3d Right = FVector3d::RightVector;
+	FVector3d Up = FVector3d::UpVector;
+	double TanHalfFovX = 1.0;
+	double TanHalfFovY = 1.0;
+
+	// Unnormalized world direction through a point in normalized device coordinates ([-1, 1], +Y up)
+	FVector3d GetRayDirection(double NdcX, double NdcY) const
+	{
+		return Forward + Right * (NdcX * TanHalfFovX) + Up * (NdcY * TanHalfFovY);
+	}
+};
+
+/** Immutable packed orbit data for the shader, one buffer row per reference. Published whole by the game thread. */
+struct FFractalOrbitSnapshot
+{
+	uint64 Generation = 0;                  // Bumped on every change to the primary, grid or secondary rows
+	uint64 OrbitVersion = 0;                // Primary orbit version the rows belong to
+	TArray<uint64> RowVersions;             // Per row; a row keeps its version across snapshots while its data is unchanged
+	TArray<FVector3f> PositionData;         // Rows packed back to back, no padding; empty when compact
+	TArray<FVector3f> DerivativeData;       // Same layout; empty unless every row has derivatives
+	TArray<FUintVector2> CompactPositionData; // FCompactOrbitEncoding rows, each padded to whole blocks
+	TArray<float> CompactScaleData;         // Same layout; empty unless every row has derivatives
+	TArray<FVector4f> CompactBlockData;     // Block headers of all compact rows
+	TArray<FVector4f> SeriesData;           // Series table per row; empty unless every row has one
+	TArray<FVector4f> ReferenceCenters;     // (center, orbit length) per row
+	TArray<uint32> RowOffsets;              // First point element of each row
+	bool bHasDerivatives = false;
+	bool bHasSeriesApproximation = false;
+	bool bCompactEncoding = false;
+};
+
 /**
  * Scene View Extension for rendering fractals directly into the post-process pipeline
  * Automatically renders every frame without needing Blueprint calls
+ *
+ * Parameters and orbit data reach the render thread through triple buffers: the game thread
+ * publishes a new value (orbits as an immutable shared snapshot) and the render thread picks up
+ * the newest one without taking a lock or copying orbit arrays.
  */
 class FRACTALRENDERER_API FFractalSceneViewExtension : public FSceneViewExtensionBase
 {
@@ -28,28 +124,256 @@ public:
 	// Post-process pass subscription
 	virtual void SubscribeToPostProcessingPass(EPostProcessingPass PassId, const FSceneView& View, FPostProcessingPassDelegateArray& InOutPassCallbacks, bool bIsPassEnabled) override;
 
-	// Set fractal parameters from game thread
-	void SetFractalParameters(const FFractalParameter& InParams);
+	// Set fractal parameters from game thread. InConfiguredIterations is the iteration count before the quality governor
+	// lowered it, which defines the surface the depth history belongs to.
+	void SetFractalParameters(const FFractalParameter& InParams, int32 InConfiguredIterations);
+
+	// Set reference orbit data (called by subsystem when a newer orbit version is published); drops grid and secondary orbits
+	void SetReferenceOrbit(const FReferenceOrbit& InOrbit, uint64 InVersion);
+
+	// Set the grid of reference orbits spread over the marched frustum; ignored unless they belong to the current primary orbit.
+	// Grid rows take precedence, so secondaries that no longer fit are dropped.
+	void SetGridOrbits(const TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>>& InOrbits, uint64 InPrimaryVersion);
 
-	// Set reference orbit data (called by subsystem when orbit regenerates)
-	void SetReferenceOrbit(const FReferenceOrbit& InOrbit);
+	// Set the secondary reference orbits placed on glitch clusters; ignored unless they belong to the current primary orbit
+	void SetSecondaryOrbits(const TArray<TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>>& InOrbits, uint64 InPrimaryVersion);
+
+	// Take the latest glitch report if one arrived since the previous call (game thread)
+	bool ConsumeGlitchReport(FFractalGlitchReport& OutReport);
+
+	// Frustum the fractal was last rendered with; false until a view has been rendered
+	bool GetLastViewFrustum(FFractalViewFrustum& OutFrustum) const;
+
+	// March counters of the newest frame whose readback completed; false until one has
+	bool GetLatestMarchStats(FFractalMarchStats& OutStats) const;
+
+	// March histogram of the newest frame whose readback completed; false until one has (needs Fractal.Debug.MarchHistogram)
+	bool GetLatestMarchHistogram(FFractalMarchHistogram& OutHistogram) const;
+
+	// Render thread cost of the newest rendered view; false until one has been rendered
+	bool GetLatestRenderThreadStats(FFractalRenderThreadStats& OutStats) const;
+
+	// Take the GPU time in milliseconds of the newest measured frame's fractal passes (cone prepass and main pass)
+	// if one arrived since the previous call (game thread). Never succeeds on RHIs without timestamp queries.
+	bool ConsumeGpuTime(float& OutMilliseconds);
 
 private:
 	// Callback for rendering the fractal
 	FScreenPassTexture RenderFractal_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& Inputs);
 
-	// Create and upload orbit texture to RDG
-	FRDGTextureRef CreateOrbitTexture(FRDGBuilder& GraphBuilder, const TArray<FVector4f>& OrbitData);
+	// Create and upload an orbit structured buffer (positions, derivatives or series coefficients) to RDG
+	template<typename ElementType>
+	FRDGBufferRef CreateOrbitBuffer(FRDGBuilder& GraphBuilder, const TArray<ElementType>& OrbitData, const TCHAR* Name);
+
+	// Create a single zeroed element as a stand-in when no orbit data is available
+	FRDGBufferSRVRef CreateDummyOrbitBuffer(FRDGBuilder& GraphBuilder, uint32 BytesPerElement, const TCHAR* Name);
 
-	// Thread-safe storage for fractal parameters
-	FFractalParameter FractalParameters;
-	FCriticalSection ParameterMutex;
+	// Parameters handed from the game thread (writer) to the render thread (reader)
+	struct FRenderParameters
+	{
+		FFractalParameter Parameters;   // As rendered, after the quality governor
+		int32 ConfiguredIterations = 0; // MaxIterations before the governor lowered it
+	};
+	TTripleBuffer<FRenderParameters> ParameterBuffer;
+	FCriticalSection ParameterWriteMutex;
 
-	// Thread-safe storage for orbit data
-	TArray<FVector4f> OrbitPositionData;
-	TArray<FVector4f> OrbitDerivativeData;
-	FVector3d CurrentReferenceCenter;
-	int32 CurrentOrbitLength;
-	bool bOrbitHasDerivatives;
+	// Upload-ready views of one reference orbit, either as float3 or compactly encoded
+	struct FOrbitRow
+	{
+		TArray<FVector3f> Positions;
+		TArray<FVector3f> Derivatives;
+		FCompactOrbitEncoding Compact;
+		TArray<FVector4f> Series;
+		FVector3d ReferenceCenter = FVector3d::ZeroVector;
+		int32 NumPoints = 0;
+		bool bHasDerivatives = false;
+		uint64 Version = 0;
+		TWeakPtr<const FReferenceOrbit, ESPMode::ThreadSafe> Source; // Grid and secondary rows only
+	};
+
+	// Copy an orbit's upload-ready views into a row, or encode them compactly
+	static FOrbitRow MakeOrbitRow(const FReferenceOrbit& InOrbit, bool bCompact);
+
+	// Move the row of Orbit out of PreviousRows if it is there, keeping its data and version; otherwise make a new one
+	FOrbitRow TakeOrMakeOrbitRow(TArray<FOrbitRow>& PreviousRows, const TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>& Orbit);
+
+	// Pack OrbitRows into a new snapshot and publish it to the render thread (caller holds OrbitMutex)
+	void PackOrbitRows();
+
+	struct FOrbitGpuResources;
+
+	// Allocate buffers for a newer snapshot generation, then stream the next chunks of whichever set is incomplete (render thread)
+	void UpdateOrbitGpuResources(FRDGBuilder& GraphBuilder, const TSharedPtr<const FFractalOrbitSnapshot, ESPMode::ThreadSafe>& Snapshot);
+
+	// Full-size, still empty buffers for a snapshot, with its series table already uploaded (render thread)
+	FOrbitGpuResources AllocateOrbitGpuResources(FRDGBuilder& GraphBuilder, const TSharedPtr<const FFractalOrbitSnapshot, ESPMode::ThreadSafe>& Snapshot);
+
+	// Copy the rows Source has resident into Target's rows of the same version, on the GPU (render thread)
+	void CopyResidentOrbitRows(FRDGBuilder& GraphBuilder, const FOrbitGpuResources& Source, FOrbitGpuResources& Target);
+
+	// Upload the next chunks of a resource set's snapshot within the per-frame budget (render thread)
+	void StreamOrbitChunks(FRDGBuilder& GraphBuilder, FOrbitGpuResources& Resources);
+
+	// Copy Data[FirstElement, FirstElement + NumElements) into the same range of a pooled buffer; returns the bytes uploaded.
+	// Owner is the snapshot Data belongs to, held until the copy has run.
+	template<typename ElementType>
+	int64 AddOrbitChunkUploadPass(FRDGBuilder& GraphBuilder, const TRefCountPtr<FRDGPooledBuffer>& PooledBuffer, const TArray<ElementType>& Data, int32 FirstElement, int32 NumElements,
+		const TSharedPtr<const FFractalOrbitSnapshot, ESPMode::ThreadSafe>& Owner);
+
+	// Decode glitch readbacks the GPU has finished and hand the newest to the game thread (render thread)
+	void PollGlitchReadbacks();
+
+	// Publish the newest finished march counter readback to the stats system and the game thread (render thread)
+	void PollMarchStatsReadbacks();
+
+	// Decode the newest finished march histogram readback and publish it to the stats system and the game thread (render thread)
+	void PollMarchHistogramReadbacks();
+
+	// Read the pass timers the GPU has finished and hand the newest time to the game thread (render thread)
+	void PollPassTimers();
+
+	// Writer-side orbit rows: the primary orbit is row 0, then NumGridRows grid rows, then secondaries.
+	// OrbitMutex only serializes writers; the render thread reads OrbitSnapshots.
+	TArray<FOrbitRow> OrbitRows;
+	int32 NumGridRows;
+	bool bCompactOrbitRows;
+	uint64 OrbitDataGeneration;
+	uint64 LastOrbitRowVersion;
+	uint64 CurrentOrbitVersion;
 	FCriticalSection OrbitMutex;
+
+	// Packed orbit snapshots handed from the writer to the render thread
+	TTripleBuffer<TSharedPtr<const FFractalOrbitSnapshot, ESPMode::ThreadSafe>> OrbitSnapshots;
+
+	// Pooled orbit buffers streamed from Snapshot (render thread only)
+	struct FOrbitGpuResources
+	{
+		TRefCountPtr<FRDGPooledBuffer> Positions;
+		TRefCountPtr<FRDGPooledBuffer> Derivatives;
+		TRefCountPtr<FRDGPooledBuffer> Series;
+		TRefCountPtr<FRDGPooledBuffer> CompactBlocks;
+		TSharedPtr<const FFractalOrbitSnapshot, ESPMode::ThreadSafe> Snapshot;
+		int32 NumReferences = 0;
+		int32 NumPoints = 0;            // Point elements across all rows
+		int32 NumStreamedPoints = 0;    // Elements resident across all rows
+		TArray<int32> RowStreamedPoints; // Leading elements of each row already resident
+
+		bool IsFullyStreamed() const { return NumStreamedPoints >= NumPoints; }
+
+		int32 GetRowNumElements(int32 Row) const
+		{
+			return (Row + 1 < NumReferences ? static_cast<int32>(Snapshot->RowOffsets[Row + 1]) : NumPoints) - static_cast<int32>(Snapshot->RowOffsets[Row]);
+		}
+	};
+
+	// The set bound to the passes, and a newer one for the same primary orbit streaming in behind it. Grid and secondary
+	// changes only replace OrbitGpu once PendingOrbitGpu is fully resident, so they never shorten the bound rows.
+	FOrbitGpuResources OrbitGpu;
+	FOrbitGpuResources PendingOrbitGpu;
+
+	// Hit positions of the last frame rendered for a view and the camera they were seen from (render thread only)
+	struct FDepthHistory
+	{
+		TRefCountPtr<IPooledRenderTarget> Texture;
+		FMatrix44f TranslatedWorldToClip = FMatrix44f::Identity;
+		FVector3f PreViewTranslation = FVector3f::ZeroVector;
+		FIntPoint Extent = FIntPoint::ZeroValue;
+		FFractalParameter Parameters;
+		int32 ConfiguredIterations = 0;
+		uint64 LastUsedFrame = 0;   // GFrameCounterRenderThread when a view last rendered with it, for eviction
+	};
+
+	// Keyed by view state so several viewports keep their own; boxed because the graph extracts into them after this call returns
+	TMap<uint32, TUniquePtr<FDepthHistory>> DepthHistories;
+
+	// Per-view running average of jittered samples while nothing that shapes the image changes (render thread only)
+	struct FAccumulationHistory
+	{
+		TRefCountPtr<IPooledRenderTarget> Texture;     // (fractal color, coverage) at output resolution
+		FMatrix ViewMatrix = FMatrix::Identity;
+		FMatrix ProjectionMatrix = FMatrix::Identity;  // Without TAA jitter, which the samples bring themselves
+		FIntPoint OutputExtent = FIntPoint::ZeroValue;
+		FIntPoint MarchExtent = FIntPoint::ZeroValue;
+		FFractalParameter Parameters;
+		uint64 OrbitGeneration = 0;
+		int32 NumStreamedPoints = 0;
+		int32 NumSamples = 0;
+		uint64 LastUsedFrame = 0;
+	};
+	TMap<uint32, TUniquePtr<FAccumulationHistory>> Accumulations;
+
+	// Glitch buffer readbacks in flight (render thread only)
+	struct FGlitchReadback
+	{
+		TUniquePtr<FRHIGPUBufferReadback> Readback;
+		uint64 OrbitVersion = 0;
+		int32 NumReferences = 0;
+		uint64 SubmitIndex = 0;
+		bool bInFlight = false;
+	};
+	TArray<FGlitchReadback> GlitchReadbacks;
+	uint64 NumGlitchReadbacksSubmitted;
+
+	// Newest decoded glitch report, waiting for the game thread
+	FFractalGlitchReport PendingGlitchReport;
+	bool bHasPendingGlitchReport;
+	FCriticalSection GlitchMutex;
+
+	// March counter readbacks in flight (render thread only)
+	struct FMarchStatsReadback
+	{
+		TUniquePtr<FRHIGPUBufferReadback> Readback;
+		uint64 SubmitIndex = 0;
+		bool bInFlight = false;
+	};
+	TArray<FMarchStatsReadback> MarchStatsReadbacks;
+	uint64 NumMarchStatsSubmitted;
+
+	// March histogram readbacks in flight, with the budgets that set their bucket ranges (render thread only)
+	struct FMarchHistogramReadback
+	{
+		TUniquePtr<FRHIGPUBufferReadback> Readback;
+		int32 MaxRaySteps = 0;
+		int32 MaxIterations = 0;
+		uint64 SubmitIndex = 0;
+		bool bInFlight = false;
+	};
+	TArray<FMarchHistogramReadback> MarchHistogramReadbacks;
+	uint64 NumMarchHistogramsSubmitted;
+
+	// Newest decoded march counters and histogram, both under MarchStatsMutex
+	FFractalMarchStats LatestMarchStats;
+	bool bHasMarchStats;
+	FFractalMarchHistogram LatestMarchHistogram;
+	bool bHasMarchHistogram;
+	mutable FCriticalSection MarchStatsMutex;
+
+	// Timestamp query pairs around the fractal passes, in flight until both results are available (render thread only)
+	struct FPassTimer
+	{
+		FRHIPooledRenderQuery BeginQuery;
+		FRHIPooledRenderQuery EndQuery;
+		uint64 SubmitIndex = 0;
+		bool bInFlight = false;
+	};
+	TArray<FPassTimer> PassTimers;
+	FRenderQueryPoolRHIRef PassTimerQueryPool;
+	uint64 NumPassTimersSubmitted;
+
+	// Newest measured GPU time, waiting for the game thread
+	float PendingGpuTimeMs;
+	bool bHasPendingGpuTime;
+	FCriticalSection GpuTimeMutex;
+
+	// Render thread cost of the view being rendered, accumulated over the call (render thread only), then published
+	float LatestGpuMs;
+	double RenderLockWaitSeconds;
+	uint32 RenderUploadBytes;
+	FFractalRenderThreadStats LatestRenderThreadStats;
+	mutable FCriticalSection RenderStatsMutex;
+
+	// Camera of the last rendered view, for placing grid reference orbits
+	FFractalViewFrustum LastViewFrustum;
+	bool bHasLastViewFrustum;
+	mutable FCriticalSection FrustumMutex;
 };
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+/** Unreal Insights channel of the fractal pipeline; enable with -trace=default,fractal or "Trace.Enable Fractal". */
+UE_TRACE_CHANNEL_EXTERN(FractalChannel, FRACTALRENDERER_API);
+
+// CPU timing scope on the Fractal channel, in addition to the stat Fractal cycle counters
+#define FRACTAL_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, FractalChannel)
+
+// Every stage of the pipeline reports to this group: orbit jobs, orbit packing and upload, the render thread and the GPU passes
+DECLARE_STATS_GROUP(TEXT("Fractal"), STATGROUP_Fractal, STATCAT_Advanced);
+
+/**
+ * Live numbers of every pipeline stage, gathered by UFractalControlSubsystem for overlays.
+ * Unlike stat Fractal and Insights these are plain values, so they are also available in builds without stats.
+ */
+struct FFractalPipelineStats
+{
+	// Orbit jobs (background tasks) and their hand-off (game thread)
+	float OrbitGenerationMs = 0.0f;         // Wall time of the newest generated or extended primary orbit
+	float OrbitPackingMs = 0.0f;            // Converting its rows to upload-ready views and packing the snapshot
+	int32 OrbitLength = 0;                  // Points of the published primary orbit
+	int32 NumReferences = 0;                // Primary, grid and secondary orbits bound for rendering
+	float OrbitRegenerationsPerSecond = 0.0f; // Orbit requests that missed the cache, over the last second
+
+	// Render thread, newest rendered frame
+	float RenderThreadMs = 0.0f;            // RenderFractal_RenderThread, graph setup only
+	float LockWaitMs = 0.0f;                // Part of it spent waiting on locks shared with the game thread
+	uint32 UploadBytes = 0;                 // Orbit bytes uploaded that frame
+
+	// GPU, read back a few frames late
+	float GpuMs = 0.0f;                     // Cone prepass, march and resolve, from timestamp queries
+	float StepsPerPixel = 0.0f;
+	float GovernorQuality = 1.0f;
+};
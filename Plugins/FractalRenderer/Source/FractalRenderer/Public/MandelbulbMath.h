@@ -0,0 +1,366 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Spherical power map g_p(z) used by the Mandelbulb iteration z_{n+1} = g_p(z_n) + C.
+ *
+ * For integer powers the map has a closed form that needs no trigonometry:
+ *   cos(theta) = z / r,   sin(theta) = rho / r   (rho = sqrt(x^2 + y^2))
+ *   cos(phi)   = x / rho, sin(phi)   = y / rho
+ * and cos(p*a) + i*sin(p*a) = (cos(a) + i*sin(a))^p, expanded by repeated complex
+ * multiplication. The power is a template argument so every expansion is unrolled at
+ * compile time; callers select the specialization once per orbit rather than per iteration.
+ */
+namespace MandelbulbMath
+{
+	/** Below this radius the spherical angles are undefined and treated as zero (matches the trig path). */
+	constexpr double AngleEpsilon = 1e-10;
+
+	/** Smallest and largest power with a compile-time polynomial specialization. */
+	constexpr int32 MinPolynomialPower = 2;
+	constexpr int32 MaxPolynomialPower = 8;
+
+	/** Scalar hooks found by unqualified lookup; extended-precision types provide their own overloads. */
+	FORCEINLINE double Sqrt(double V) { return FMath::Sqrt(V); }
+	FORCEINLINE double ToDouble(double V) { return V; }
+
+	/**
+	 * Minimal 3-vector over an arbitrary real type, so orbit code can be instantiated for
+	 * double as well as extended-precision scalars (FVector3d only supports float/double).
+	 */
+	template <typename T>
+	struct TVec3
+	{
+		T X, Y, Z;
+
+		FORCEINLINE TVec3() : X(0.0), Y(0.0), Z(0.0) {}
+		FORCEINLINE TVec3(const T& InX, const T& InY, const T& InZ) : X(InX), Y(InY), Z(InZ) {}
+		FORCEINLINE explicit TVec3(const FVector3d& V) : X(V.X), Y(V.Y), Z(V.Z) {}
+
+		FORCEINLINE TVec3 operator+(const TVec3& B) const { return TVec3(X + B.X, Y + B.Y, Z + B.Z); }
+		FORCEINLINE TVec3 operator-(const TVec3& B) const { return TVec3(X - B.X, Y - B.Y, Z - B.Z); }
+		FORCEINLINE T SquaredLength() const { return X * X + Y * Y + Z * Z; }
+
+		/** Round to double precision (drops the low-order part of extended types). */
+		FORCEINLINE FVector3d ToVector3d() const { return FVector3d(ToDouble(X), ToDouble(Y), ToDouble(Z)); }
+	};
+
+	/**
+	 * Second-order truncated Taylor series V + D1*t + D2*t^2 in one scalar variable t.
+	 * Evaluating the polynomial power map on it propagates the first two series coefficients of
+	 * the orbit along a direction in C, which is what the series approximation needs.
+	 */
+	struct FJet2
+	{
+		double V, D1, D2;
+
+		FORCEINLINE FJet2() : V(0.0), D1(0.0), D2(0.0) {}
+		FORCEINLINE FJet2(double InValue) : V(InValue), D1(0.0), D2(0.0) {}
+		FORCEINLINE FJet2(double InV, double InD1, double InD2) : V(InV), D1(InD1), D2(InD2) {}
+
+		FORCEINLINE FJet2 operator-() const { return FJet2(-V, -D1, -D2); }
+		FORCEINLINE friend FJet2 operator+(const FJet2& A, const FJet2& B) { return FJet2(A.V + B.V, A.D1 + B.D1, A.D2 + B.D2); }
+		FORCEINLINE friend FJet2 operator-(const FJet2& A, const FJet2& B) { return FJet2(A.V - B.V, A.D1 - B.D1, A.D2 - B.D2); }
+		FORCEINLINE friend FJet2 operator*(const FJet2& A, const FJet2& B)
+		{
+			return FJet2(A.V * B.V, A.V * B.D1 + A.D1 * B.V, A.V * B.D2 + A.D1 * B.D1 + A.D2 * B.V);
+		}
+		FORCEINLINE friend FJet2 operator/(const FJet2& A, const FJet2& B)
+		{
+			const double Q0 = A.V / B.V;
+			const double Q1 = (A.D1 - Q0 * B.D1) / B.V;
+			const double Q2 = (A.D2 - Q0 * B.D2 - Q1 * B.D1) / B.V;
+			return FJet2(Q0, Q1, Q2);
+		}
+
+		FORCEINLINE friend bool operator>(const FJet2& A, double B) { return A.V > B; }
+		FORCEINLINE friend bool operator<(const FJet2& A, double B) { return A.V < B; }
+	};
+
+	/** Square root of a jet; the series is undefined at zero, where it is treated as constant. */
+	FORCEINLINE FJet2 Sqrt(const FJet2& A)
+	{
+		if (A.V <= 0.0)
+		{
+			return FJet2(0.0);
+		}
+
+		const double S0 = FMath::Sqrt(A.V);
+		const double S1 = A.D1 / (2.0 * S0);
+		const double S2 = (A.D2 - S1 * S1) / (2.0 * S0);
+		return FJet2(S0, S1, S2);
+	}
+
+	FORCEINLINE double ToDouble(const FJet2& A) { return A.V; }
+
+	/**
+	 * Four doubles evaluated in lockstep: one AVX register where the platform math layer uses AVX,
+	 * a pair of SSE registers otherwise. Lets orbit code run on independent points side by side.
+	 * Lanes cannot be branched on; comparisons return a lane mask for Select.
+	 */
+	struct FDouble4
+	{
+		static constexpr int32 NumLanes = 4;
+
+		VectorRegister4Double V;
+
+		FORCEINLINE FDouble4() : V(MakeVectorRegisterDouble(0.0, 0.0, 0.0, 0.0)) {}
+		FORCEINLINE FDouble4(double InValue) : V(MakeVectorRegisterDouble(InValue, InValue, InValue, InValue)) {}
+		FORCEINLINE FDouble4(const VectorRegister4Double& InV) : V(InV) {}
+
+		/** Load NumLanes consecutive values (no alignment required). */
+		static FORCEINLINE FDouble4 Load(const double* Values) { return FDouble4(VectorLoad(Values)); }
+		FORCEINLINE void Store(double* OutValues) const { VectorStore(V, OutValues); }
+
+		FORCEINLINE friend FDouble4 operator+(const FDouble4& A, const FDouble4& B) { return VectorAdd(A.V, B.V); }
+		FORCEINLINE friend FDouble4 operator-(const FDouble4& A, const FDouble4& B) { return VectorSubtract(A.V, B.V); }
+		FORCEINLINE friend FDouble4 operator*(const FDouble4& A, const FDouble4& B) { return VectorMultiply(A.V, B.V); }
+		FORCEINLINE friend FDouble4 operator/(const FDouble4& A, const FDouble4& B) { return VectorDivide(A.V, B.V); }
+	};
+
+	FORCEINLINE FDouble4 Sqrt(const FDouble4& A) { return VectorSqrt(A.V); }
+
+	FORCEINLINE FDouble4 Max(const FDouble4& A, const FDouble4& B) { return VectorMax(A.V, B.V); }
+
+	/** All-ones lanes where A > B (or A < B). */
+	FORCEINLINE FDouble4 CompareGT(const FDouble4& A, const FDouble4& B) { return VectorCompareGT(A.V, B.V); }
+	FORCEINLINE FDouble4 CompareLT(const FDouble4& A, const FDouble4& B) { return VectorCompareLT(A.V, B.V); }
+	FORCEINLINE FDouble4 MaskAnd(const FDouble4& A, const FDouble4& B) { return VectorBitwiseAnd(A.V, B.V); }
+
+	/** Per lane, A where Mask is set and B elsewhere. */
+	FORCEINLINE FDouble4 Select(const FDouble4& Mask, const FDouble4& A, const FDouble4& B) { return VectorSelect(Mask.V, A.V, B.V); }
+
+	/** One bit per lane, lane 0 in the lowest bit. */
+	FORCEINLINE int32 MaskBits(const FDouble4& Mask) { return static_cast<int32>(VectorMaskBits(Mask.V)); }
+
+	/** Lanes whose bit is set in Bits, lane 0 in the lowest bit (the inverse of MaskBits). */
+	FORCEINLINE FDouble4 MaskFromBits(int32 Bits)
+	{
+		return CompareGT(FDouble4(MakeVectorRegisterDouble(
+			(Bits & 1) ? 1.0 : 0.0, (Bits & 2) ? 1.0 : 0.0, (Bits & 4) ? 1.0 : 0.0, (Bits & 8) ? 1.0 : 0.0)), FDouble4(0.5));
+	}
+
+	/** X^N by square-and-multiply, fully unrolled. */
+	template <int32 N, typename T>
+	FORCEINLINE T IntPow(const T& X)
+	{
+		static_assert(N >= 1, "IntPow requires a positive exponent");
+		if constexpr (N == 1)
+		{
+			return X;
+		}
+		else
+		{
+			const T Half = IntPow<N / 2>(X);
+			if constexpr (N % 2 == 0)
+			{
+				return Half * Half;
+			}
+			else
+			{
+				return Half * Half * X;
+			}
+		}
+	}
+
+	/** (Re + i*Im)^N by square-and-multiply, fully unrolled. */
+	template <int32 N, typename T>
+	FORCEINLINE void ComplexPow(const T& Re, const T& Im, T& OutRe, T& OutIm)
+	{
+		static_assert(N >= 1, "ComplexPow requires a positive exponent");
+		if constexpr (N == 1)
+		{
+			OutRe = Re;
+			OutIm = Im;
+		}
+		else
+		{
+			T HalfRe, HalfIm;
+			ComplexPow<N / 2>(Re, Im, HalfRe, HalfIm);
+
+			// (a + ib)^2 = a^2 - b^2 + 2iab
+			const T SqRe = HalfRe * HalfRe - HalfIm * HalfIm;
+			const T SqIm = (HalfRe + HalfRe) * HalfIm;
+
+			if constexpr (N % 2 == 0)
+			{
+				OutRe = SqRe;
+				OutIm = SqIm;
+			}
+			else
+			{
+				OutRe = SqRe * Re - SqIm * Im;
+				OutIm = SqRe * Im + SqIm * Re;
+			}
+		}
+	}
+
+	/**
+	 * Trig-free g_p(z) for integer power P. T must provide +, -, *, /, comparison with double,
+	 * construction from double and an unqualified Sqrt(T) found by overload resolution.
+	 */
+	template <int32 P, typename T>
+	FORCEINLINE void PolynomialPowerMap(const T& X, const T& Y, const T& Z, T& OutX, T& OutY, T& OutZ)
+	{
+		const T RhoSq = X * X + Y * Y;
+		const T R = Sqrt(RhoSq + Z * Z);
+
+		// Unit direction cosines of the polar (theta) and azimuthal (phi) angles
+		T CosTheta(1.0), SinTheta(0.0), CosPhi(1.0), SinPhi(0.0);
+		if (R > AngleEpsilon)
+		{
+			const T Rho = Sqrt(RhoSq);
+			CosTheta = Z / R;
+			SinTheta = Rho / R;
+			if (Rho > 0.0)
+			{
+				CosPhi = X / Rho;
+				SinPhi = Y / Rho;
+			}
+		}
+
+		T CosPTheta, SinPTheta, CosPPhi, SinPPhi;
+		ComplexPow<P>(CosTheta, SinTheta, CosPTheta, SinPTheta);
+		ComplexPow<P>(CosPhi, SinPhi, CosPPhi, SinPPhi);
+
+		const T RPowered = IntPow<P>(R);
+		const T RSin = RPowered * SinPTheta;
+		OutX = RSin * CosPPhi;
+		OutY = RSin * SinPPhi;
+		OutZ = RPowered * CosPTheta;
+	}
+
+	/** Lane-wise g_p(z); the degenerate-angle cases of the scalar map are selected per lane instead of branched on. */
+	template <int32 P>
+	FORCEINLINE void PolynomialPowerMap(const FDouble4& X, const FDouble4& Y, const FDouble4& Z, FDouble4& OutX, FDouble4& OutY, FDouble4& OutZ)
+	{
+		const FDouble4 RhoSq = X * X + Y * Y;
+		const FDouble4 R = Sqrt(RhoSq + Z * Z);
+		const FDouble4 Rho = Sqrt(RhoSq);
+
+		const FDouble4 HasAngles = CompareGT(R, FDouble4(AngleEpsilon));
+		const FDouble4 HasAzimuth = MaskAnd(HasAngles, CompareGT(Rho, FDouble4(0.0)));
+		const FDouble4 SafeR = Select(HasAngles, R, FDouble4(1.0));
+		const FDouble4 SafeRho = Select(HasAzimuth, Rho, FDouble4(1.0));
+		const FDouble4 CosTheta = Select(HasAngles, Z / SafeR, FDouble4(1.0));
+		const FDouble4 SinTheta = Select(HasAngles, Rho / SafeR, FDouble4(0.0));
+		const FDouble4 CosPhi = Select(HasAzimuth, X / SafeRho, FDouble4(1.0));
+		const FDouble4 SinPhi = Select(HasAzimuth, Y / SafeRho, FDouble4(0.0));
+
+		FDouble4 CosPTheta, SinPTheta, CosPPhi, SinPPhi;
+		ComplexPow<P>(CosTheta, SinTheta, CosPTheta, SinPTheta);
+		ComplexPow<P>(CosPhi, SinPhi, CosPPhi, SinPPhi);
+
+		const FDouble4 RPowered = IntPow<P>(R);
+		const FDouble4 RSin = RPowered * SinPTheta;
+		OutX = RSin * CosPPhi;
+		OutY = RSin * SinPPhi;
+		OutZ = RPowered * CosPTheta;
+	}
+
+	/** Reference g_p(z) for arbitrary (non-integer) powers using spherical coordinates. */
+	FORCEINLINE FVector3d TrigPowerMap(const FVector3d& V, double Power)
+	{
+		const double R = FMath::Sqrt(V.X * V.X + V.Y * V.Y + V.Z * V.Z);
+
+		double Theta = 0.0;
+		double Phi = 0.0;
+		if (R > AngleEpsilon)
+		{
+			// theta = acos(z/r), clamped to [-1, 1] for numerical stability; phi = atan2(y, x)
+			Theta = FMath::Acos(FMath::Clamp(V.Z / R, -1.0, 1.0));
+			Phi = FMath::Atan2(V.Y, V.X);
+		}
+
+		const double RPowered = FMath::Pow(R, Power);
+		const double ThetaNew = Power * Theta;
+		const double PhiNew = Power * Phi;
+		const double SinTheta = FMath::Sin(ThetaNew);
+
+		return FVector3d(
+			RPowered * SinTheta * FMath::Cos(PhiNew),
+			RPowered * SinTheta * FMath::Sin(PhiNew),
+			RPowered * FMath::Cos(ThetaNew)
+		);
+	}
+
+	/** Trig-free g_p(z) for an integer power known at compile time. */
+	template <int32 P>
+	FORCEINLINE FVector3d PolynomialPowerMap(const FVector3d& V)
+	{
+		FVector3d Result;
+		PolynomialPowerMap<P>(V.X, V.Y, V.Z, Result.X, Result.Y, Result.Z);
+		return Result;
+	}
+
+	/**
+	 * Returns the integer power with a polynomial specialization matching Power,
+	 * or 0 when Power must take the trig path.
+	 */
+	FORCEINLINE int32 GetPolynomialPower(double Power)
+	{
+		const double Rounded = FMath::RoundToDouble(Power);
+		if (FMath::Abs(Power - Rounded) > 1e-9)
+		{
+			return 0;
+		}
+
+		const int32 IntegerPower = static_cast<int32>(Rounded);
+		return (IntegerPower >= MinPolynomialPower && IntegerPower <= MaxPolynomialPower) ? IntegerPower : 0;
+	}
+
+	/**
+	 * Invokes Functor.template operator()<P>() for the polynomial specialization of Power,
+	 * or Functor.template operator()<0>() for the trig fallback. Lets hot loops be
+	 * instantiated once per power instead of branching inside the iteration.
+	 */
+	template <typename FunctorType>
+	FORCEINLINE decltype(auto) DispatchPower(double Power, FunctorType&& Functor)
+	{
+		switch (GetPolynomialPower(Power))
+		{
+		case 2: return Functor.template operator()<2>();
+		case 3: return Functor.template operator()<3>();
+		case 4: return Functor.template operator()<4>();
+		case 5: return Functor.template operator()<5>();
+		case 6: return Functor.template operator()<6>();
+		case 7: return Functor.template operator()<7>();
+		case 8: return Functor.template operator()<8>();
+		default: return Functor.template operator()<0>();
+		}
+	}
+
+	/** g_p(z) selecting the polynomial specialization when P > 0 and the trig path otherwise. */
+	template <int32 P>
+	FORCEINLINE FVector3d PowerMap(const FVector3d& V, double Power)
+	{
+		if constexpr (P > 0)
+		{
+			return PolynomialPowerMap<P>(V);
+		}
+		else
+		{
+			return TrigPowerMap(V, Power);
+		}
+	}
+
+	/**
+	 * g_p(z) over any real type. The polynomial path keeps full precision of T; the trig fallback
+	 * for non-integer powers is evaluated in double, so extended types lose their low-order bits there.
+	 */
+	template <int32 P, typename T>
+	FORCEINLINE TVec3<T> PowerMap(const TVec3<T>& V, double Power)
+	{
+		if constexpr (P > 0)
+		{
+			TVec3<T> Result;
+			PolynomialPowerMap<P>(V.X, V.Y, V.Z, Result.X, Result.Y, Result.Z);
+			return Result;
+		}
+		else
+		{
+			return TVec3<T>(TrigPowerMap(V.ToVector3d(), Power));
+		}
+	}
+}
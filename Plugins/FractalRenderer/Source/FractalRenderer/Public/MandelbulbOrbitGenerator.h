@@ -1,65 +1,216 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "FractalParameter.h"
+#include "MandelbulbMath.h"
 
 /**
- * High-precision orbit data for a single iteration
+ * Truncated series approximation of the perturbation term, eps_n ~= A_n * delta with
+ * delta = C - C_0 and A_n the 3x3 Jacobian of z_n with respect to C.
+ *
+ * The range over which the first-order term is accurate shrinks with |delta|, so it is tabulated
+ * per radius bucket: bucket k covers |delta| <= 2^-k and stores the last iteration S_k at which the
+ * approximation is still valid together with A_{S_k}. The shader starts perturbation at S_k
+ * instead of 0. S_k = 0 means no skip. Validity is judged by the ratio of the second-order term to
+ * the first along several probe directions and by keeping eps well inside |Z_n|, where the expansion
+ * of the power map converges; no bucket skips past where the pixel could escape.
  */
-struct FOrbitPoint
+struct FRACTALRENDERER_API FOrbitSeriesApproximation
 {
-	FVector3d Position;      // z_n in double precision
-	FVector3d Derivative;    // dz_n/dc in double precision
-	int32 Iteration;         // Iteration index
-	bool bEscaped;          // Whether this point exceeded bailout
-
-	FOrbitPoint()
-		: Position(FVector3d::ZeroVector)
-		, Derivative(FVector3d::ZeroVector)
-		, Iteration(0)
-		, bEscaped(false)
-	{
-	}
+	static constexpr int32 NumRadiusBuckets = 48;
 
-	FOrbitPoint(const FVector3d& InPosition, const FVector3d& InDerivative, int32 InIteration, bool InEscaped)
-		: Position(InPosition)
-		, Derivative(InDerivative)
-		, Iteration(InIteration)
-		, bEscaped(InEscaped)
-	{
-	}
+	/** Texels per bucket in the GPU view: (A row 0, S_k), (A row 1, dr_{S_k}), (A row 2, 0). */
+	static constexpr int32 TexelsPerBucket = 3;
+
+	/** Largest allowed |second-order term| / |first-order term| over the skipped iterations. */
+	static constexpr double DefaultTolerance = 1e-3;
+
+	/** Upload-ready table, NumRadiusBuckets * TexelsPerBucket texels; empty when unavailable. */
+	TArray<FVector4f> GpuData;
+
+	/** Set by ClampToLength when it cut a bucket short; only a rebuild restores such buckets once the orbit grows. */
+	bool bHasClampedBuckets = false;
+
+	bool IsValid() const { return GpuData.Num() == NumRadiusBuckets * TexelsPerBucket; }
+
+	void Reset() { GpuData.Reset(); bHasClampedBuckets = false; }
+
+	/** Bucket for a given |delta|, or INDEX_NONE when it is too large for any bucket. */
+	static int32 GetBucket(double DeltaLength);
+
+	/** Store S_k, the columns of A_{S_k} and the reference's running derivative there for a bucket. */
+	void SetBucket(int32 Bucket, int32 SkipIteration, const FVector3d (&Columns)[3], double RunningDerivative);
+
+	/** First iteration the perturbation loop runs for this bucket. */
+	int32 GetSkipIteration(int32 Bucket) const;
+
+	/** The reference's running derivative dr at the bucket's skip iteration, where perturbation starts. */
+	double GetStartDerivative(int32 Bucket) const;
+
+	/** eps_{S_k} ~= A_{S_k} * Delta, evaluated from the stored float coefficients like the shader does. */
+	FVector3d Evaluate(int32 Bucket, const FVector3d& Delta) const;
+
+	/** Largest S_k over all buckets (0 when unavailable). */
+	int32 GetMaxSkipIteration() const;
+
+	/**
+	 * Keep the table valid for the orbit cut to InLength points without rebuilding it. Buckets skipping past
+	 * the new end take the entry of the next larger bucket that does not, which holds for them too since
+	 * validity only shrinks with the radius; bucket 0 falls back to no skip (dr_0 = InitialDerivative).
+	 */
+	void ClampToLength(int32 InLength, double InitialDerivative);
 };
 
 /**
- * Complete reference orbit data
+ * Complete reference orbit data.
+ *
+ * Stored as structure-of-arrays in a single allocation laid out as
+ *   [X | Y | Z]                 double position channels (z_n)
+ *   [GPU positions]             float3 (x, y, z) per point, upload-ready
+ *   [GPU derivatives]           float3 (dr_n, p*|z_n|^(p-1), |z_n|) per point, upload-ready
+ * The float views are written as points are generated, so they can be handed to RDG directly.
+ * Per-point iteration indices and escape flags are implicit (index, EscapeIteration).
+ *
+ * Lowering the iteration limit only shortens the active length; computed points past it stay in
+ * storage, and ResumeState keeps what is needed to continue the recurrence from the last one.
  */
-struct FReferenceOrbit
+struct FRACTALRENDERER_API FReferenceOrbit
 {
-	TArray<FOrbitPoint> Points;    // Sequence z_0, z_1, ..., z_N
+	/** Recurrence state at the last computed point, so generation can resume without recomputing. */
+	struct FResumeState
+	{
+		FVector3d TailLow = FVector3d::ZeroVector;   // Low-order parts of z at the last computed point (double-double only)
+		FVector3d CenterLow = FVector3d::ZeroVector; // Low-order parts of C_0 (double-double only)
+		double RunningDerivative = 1.0;              // dr at the last computed point, before rounding to float
+	};
+
 	FVector3d ReferenceCenter;     // C_0 in fractal space
 	double Power;                   // Fractal power (typically 8.0)
 	double BailoutRadius;          // Escape threshold
 	int32 EscapeIteration;         // Iteration where orbit escaped (-1 if never)
+	EFractalOrbitPrecision Precision; // Real type the recurrence was evaluated in
 	bool bValid;                   // Whether orbit is valid for use
 	bool bHasDerivatives;          // Whether derivative data has been populated
+	FResumeState ResumeState;      // Valid while the computed points have not escaped
+	FOrbitSeriesApproximation SeriesApproximation; // Iteration skip table for the active length
 
 	FReferenceOrbit()
 		: ReferenceCenter(FVector3d::ZeroVector)
 		, Power(8.0)
 		, BailoutRadius(2.0)
 		, EscapeIteration(-1)
+		, Precision(EFractalOrbitPrecision::Double)
 		, bValid(false)
 		, bHasDerivatives(false)
+		, NumPoints(0)
+		, NumComputedPoints(0)
+		, ComputedEscapeIteration(-1)
+		, Capacity(0)
 	{
 	}
 
+	/** Copy of Other laid out for at least InCapacity points, so extending the copy that far does not re-lay it out. */
+	FReferenceOrbit(const FReferenceOrbit& Other, int32 InCapacity);
+
 	/** Get orbit length */
-	int32 GetLength() const { return Points.Num(); }
+	int32 GetLength() const { return NumPoints; }
 
 	/** Check if orbit is valid and usable */
-	bool IsValid() const { return bValid && Points.Num() > 0; }
+	bool IsValid() const { return bValid && NumPoints > 0; }
 
 	/** Helper to query derivative availability */
 	bool HasDerivatives() const { return bHasDerivatives; }
+
+	/** Ensure room for InCapacity points; re-lays out the single allocation if it must grow. */
+	void Reserve(int32 InCapacity);
+
+	/** Drop all points, keeping the allocation. */
+	void Reset() { DiscardFrom(0); }
+
+	/** Number of points generated so far, including any retained past the active length. */
+	int32 GetComputedLength() const { return NumComputedPoints; }
+
+	/** Whether more iterations can be appended to the computed points (they have not escaped). */
+	bool CanResume() const { return NumComputedPoints > 0 && ComputedEscapeIteration < 0; }
+
+	/**
+	 * Expose z_0..z_MaxIterations (or as many as were computed) in place. Lowering truncates without
+	 * reallocating; raising again within the computed points restores them for free.
+	 */
+	void SetIterationLimit(int32 InMaxIterations);
+
+	/** Permanently drop computed points from InLength on (used to roll back a cancelled extension). */
+	void DiscardFrom(int32 InLength);
+
+	/** Append z_n after the last computed point; its derivative slot is zeroed until SetDerivative is called. Returns the point index. */
+	int32 AddPoint(const FVector3d& Position);
+
+	/** Record that z_Index exceeded the bailout radius, ending the orbit. */
+	void MarkEscaped(int32 Index);
+
+	/** Store the derivative triple (dr_n, p*|z_n|^(p-1), |z_n|) for an existing point. */
+	void SetDerivative(int32 Index, double RunningDerivative, double Scale, double Radius);
+
+	/** z_n in double precision. */
+	FVector3d GetPosition(int32 Index) const;
+
+	/** (dr_n, p*|z_n|^(p-1), |z_n|) as stored in the upload-ready float view. */
+	FVector3d GetDerivative(int32 Index) const;
+
+	/** Whether z_n exceeded the bailout radius. */
+	bool IsEscaped(int32 Index) const { return Index == EscapeIteration; }
+
+	/** Upload-ready float3 positions, one 12-byte structured-buffer element per point. */
+	TConstArrayView<FVector3f> GetGpuPositions() const { return TConstArrayView<FVector3f>(GetGpuPositionData(), NumPoints); }
+
+	/** Upload-ready float3 derivatives, one 12-byte structured-buffer element per point. */
+	TConstArrayView<FVector3f> GetGpuDerivatives() const { return TConstArrayView<FVector3f>(GetGpuDerivativeData(), NumPoints); }
+
+	/** Bytes held by the orbit's storage (double channels plus float views, including spare capacity) and its series table. */
+	SIZE_T GetAllocatedSize() const { return Storage.GetAllocatedSize() + SeriesApproximation.GpuData.GetAllocatedSize(); }
+
+	/** Bytes per point of the combined layout. */
+	static constexpr SIZE_T BytesPerPoint = 3 * sizeof(double) + 2 * sizeof(FVector3f);
+
+private:
+	TArray<uint8> Storage;
+	int32 NumPoints;
+	int32 NumComputedPoints;
+	int32 ComputedEscapeIteration;
+	int32 Capacity;
+
+	// Channel offsets derive from Capacity so copies of the orbit stay self-consistent
+	static SIZE_T GetGpuPositionOffset(int32 InCapacity) { return Align(3 * sizeof(double) * InCapacity, alignof(FVector3f)); }
+	static SIZE_T GetGpuDerivativeOffset(int32 InCapacity) { return GetGpuPositionOffset(InCapacity) + sizeof(FVector3f) * InCapacity; }
+	static SIZE_T GetStorageSize(int32 InCapacity) { return GetGpuDerivativeOffset(InCapacity) + sizeof(FVector3f) * InCapacity; }
+
+	// Lay the computed points out in a fresh allocation of OutCapacity (at least NumComputedPoints) points
+	void CopyComputedPoints(TArray<uint8>& OutStorage, int32 OutCapacity) const;
+
+	double* GetChannel(int32 Channel) { return reinterpret_cast<double*>(Storage.GetData()) + SIZE_T(Channel) * Capacity; }
+	const double* GetChannel(int32 Channel) const { return reinterpret_cast<const double*>(Storage.GetData()) + SIZE_T(Channel) * Capacity; }
+	FVector3f* GetGpuPositionData() { return reinterpret_cast<FVector3f*>(Storage.GetData() + GetGpuPositionOffset(Capacity)); }
+	const FVector3f* GetGpuPositionData() const { return reinterpret_cast<const FVector3f*>(Storage.GetData() + GetGpuPositionOffset(Capacity)); }
+	FVector3f* GetGpuDerivativeData() { return reinterpret_cast<FVector3f*>(Storage.GetData() + GetGpuDerivativeOffset(Capacity)); }
+	const FVector3f* GetGpuDerivativeData() const { return reinterpret_cast<const FVector3f*>(Storage.GetData() + GetGpuDerivativeOffset(Capacity)); }
+};
+
+/** Outcome of FMandelbulbOrbitGenerator::SelectReferenceCenter. */
+struct FReferenceCenterSearchResult
+{
+	FVector3d Center = FVector3d::ZeroVector;   // Chosen C_0 (the view center unless bCompleted)
+	int32 EscapeIteration = -1;                 // Iteration the chosen candidate escaped at (-1 if it stayed bounded)
+	int32 Period = 0;                           // Period detected for the chosen candidate (0 if none)
+	int32 BaselineEscapeIteration = -1;         // Same for the view center itself, for comparison
+	int32 NumCandidates = 0;                    // Candidates evaluated, view center included
+	double Seconds = 0.0;                       // Wall time spent searching
+	bool bCompleted = false;                    // False if cancelled or the power has no polynomial specialization
+
+	/** Orbit length (points) the chosen center yields for the searched iteration count. */
+	int32 GetOrbitLength(int32 MaxIterations) const { return EscapeIteration < 0 ? MaxIterations + 1 : EscapeIteration + 1; }
+
+	/** Orbit length the view center alone would have given. */
+	int32 GetBaselineOrbitLength(int32 MaxIterations) const { return BaselineEscapeIteration < 0 ? MaxIterations + 1 : BaselineEscapeIteration + 1; }
 };
 
 /**
@@ -72,6 +223,12 @@ struct FReferenceOrbit
  * 
  * The orbit is computed on the CPU in double precision and can be uploaded to the GPU
  * for perturbation-based rendering, allowing deep zooms beyond single-precision limits.
+ * Integer powers are iterated through compile-time polynomial specializations, so the
+ * default power of 8 needs no trigonometry.
+ *
+ * The recurrence is templated on its real type. Besides double, orbits can be generated in
+ * double-double (FDoubleDouble, ~32 significant digits) so deep zooms are not limited by the
+ * ~1e-15 rounding of the reference orbit itself. Stored points are rounded to double.
  */
 class FRACTALRENDERER_API FMandelbulbOrbitGenerator
 {
@@ -81,37 +238,92 @@ public:
 
 	/**
 	 * Generate a reference orbit for the given parameters.
+	 * Each point also carries the running scalar derivative dr_{n+1} = p*|z_n|^(p-1)*dr_n + 1 (dr_0 = 1)
+	 * together with the per-iteration scale p*|z_n|^(p-1), so the shader can reuse them instead of
+	 * evaluating pow() per pixel per iteration.
 	 * 
 	 * @param ReferenceCenter - C_0, the reference point in fractal space (typically viewport center)
 	 * @param Power - Fractal power p (typically 8.0 for classic Mandelbulb)
 	 * @param MaxIterations - Maximum number of iterations to compute
 	 * @param BailoutRadius - Escape threshold (typically 2.0)
-	 * @return Reference orbit data
+	 * @param ShouldCancel - Optional predicate polled periodically; returning true abandons the orbit
+	 * @param Precision - Real type used for the recurrence (Double or DoubleDouble; Auto is treated as Double)
+	 * @return Reference orbit data (invalid if generation was cancelled)
 	 */
 	FReferenceOrbit GenerateOrbit(
 		const FVector3d& ReferenceCenter,
 		double Power,
 		int32 MaxIterations,
-		double BailoutRadius
+		double BailoutRadius,
+		const TFunction<bool()>& ShouldCancel = TFunction<bool()>(),
+		EFractalOrbitPrecision Precision = EFractalOrbitPrecision::Double
 	) const;
 
 	/**
-	 * Convert high-precision orbit to float format for GPU upload.
-	 * Packs orbit points and derivatives as float4 arrays (x, y, z, unused).
-	 * 
-	 * @param Orbit - Source orbit in double precision
-	 * @param OutPositionData - Destination array for position float4 values
-	 * @param OutDerivativeData - Destination array for derivative float4 values
+	 * Generate a reference orbit with the recurrence evaluated in RealType.
+	 * Instantiated for double and FDoubleDouble; the latter also accepts a reference center
+	 * carrying more precision than a double can hold.
 	 */
-	static void ConvertOrbitToFloat(
-		const FReferenceOrbit& Orbit,
-		TArray<FVector4f>& OutPositionData,
-		TArray<FVector4f>& OutDerivativeData
-	);
+	template <typename RealType>
+	FReferenceOrbit GenerateOrbit(
+		const MandelbulbMath::TVec3<RealType>& ReferenceCenter,
+		double Power,
+		int32 MaxIterations,
+		double BailoutRadius,
+		const TFunction<bool()>& ShouldCancel = TFunction<bool()>()
+	) const;
+
+	/**
+	 * Bring an existing orbit to MaxIterations without recomputing its prefix.
+	 * Lowering the limit truncates in place; raising it first re-exposes retained points, then
+	 * iterates only the missing tail from the orbit's ResumeState in its original precision.
+	 * Orbits that escaped are already complete and only have their limit adjusted.
+	 *
+	 * @return false if generation was cancelled, in which case the orbit is left as it was
+	 */
+	bool ExtendOrbit(
+		FReferenceOrbit& Orbit,
+		int32 MaxIterations,
+		const TFunction<bool()>& ShouldCancel = TFunction<bool()>()
+	) const;
+
+	/**
+	 * Fill Orbit.SeriesApproximation for the orbit's active length. Coefficients are propagated
+	 * as second-order jets along the coordinate axes and the cube diagonals in double precision.
+	 * Only integer powers with a polynomial specialization are supported; others get an empty table.
+	 * Called by GenerateOrbit, and by ExtendOrbit when the orbit grows past what the table covered.
+	 *
+	 * @return false if cancelled (the previous table is left untouched)
+	 */
+	bool ComputeSeriesApproximation(
+		FReferenceOrbit& Orbit,
+		const TFunction<bool()>& ShouldCancel = TFunction<bool()>(),
+		double Tolerance = FOrbitSeriesApproximation::DefaultTolerance
+	) const;
+
+	/**
+	 * Pick a reference center near ViewCenter whose orbit survives longest, so perturbation is not
+	 * cut short by a reference that escapes early. CandidatesPerAxis^3 candidates on a cube of
+	 * half-width SearchRadius (plus ViewCenter itself) are iterated in double, four per SIMD register
+	 * and batches in parallel; bounded orbits win over escaping ones, periodic ones first, ties go to
+	 * the candidate nearest ViewCenter. Only integer powers with a polynomial specialization are searched.
+	 *
+	 * @return The chosen center; ViewCenter (with bCompleted false) if cancelled or unsupported
+	 */
+	FReferenceCenterSearchResult SelectReferenceCenter(
+		const FVector3d& ViewCenter,
+		double SearchRadius,
+		double Power,
+		int32 MaxIterations,
+		double BailoutRadius,
+		int32 CandidatesPerAxis,
+		const TFunction<bool()>& ShouldCancel = TFunction<bool()>()
+	) const;
 
 	/**
 	 * Compute a single Mandelbulb iteration: z_new = g_p(z) + C
-	 * Uses spherical coordinate transformation as per research.
+	 * Integer powers 2..8 use the trig-free polynomial form (see MandelbulbMath.h);
+	 * other powers use the spherical coordinate transformation.
 	 * 
 	 * @param Z - Current orbit point
 	 * @param C - Constant to add (reference center)
@@ -123,27 +335,4 @@ public:
 		const FVector3d& C,
 		double Power
 	);
-
-private:
-	/**
-	 * Convert Cartesian coordinates to spherical.
-	 * Returns (r, theta, phi) where:
-	 *   r = sqrt(x^2 + y^2 + z^2)
-	 *   theta = acos(z/r)  [polar angle, 0 to pi]
-	 *   phi = atan2(y, x)  [azimuthal angle, -pi to pi]
-	 */
-	static FVector3d CartesianToSpherical(const FVector3d& Cartesian);
-
-	/**
-	 * Convert spherical coordinates to Cartesian.
-	 * Input: (r, theta, phi)
-	 * Returns: (x, y, z) = (r*sin(theta)*cos(phi), r*sin(theta)*sin(phi), r*cos(theta))
-	 */
-	static FVector3d SphericalToCartesian(double R, double Theta, double Phi);
-
-	/**
-	 * Apply spherical power transform: g_p(z)
-	 * Transforms (r, theta, phi) to (r^p, p*theta, p*phi) then converts back to Cartesian.
-	 */
-	static FVector3d SphericalPowerTransform(const FVector3d& Z, double Power);
 };
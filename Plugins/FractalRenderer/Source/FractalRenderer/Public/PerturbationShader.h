@@ -6,6 +6,8 @@
 #include "GlobalShader.h"
 #include "ShaderParameterStruct.h"
 #include "FractalParameter.h"
+#include "MandelbulbOrbitGenerator.h"
+#include "CompactOrbitEncoding.h"
 #include "PerturbationShader.generated.h"
 
 // Thread counts for compute shader
@@ -13,6 +15,24 @@
 #define NUM_THREADS_PerturbationShader_Y 8
 #define NUM_THREADS_PerturbationShader_Z 1
 
+// Reference orbits bound per pass (primary, frustum grid and secondaries placed on glitch clusters), one orbit buffer row each
+#define FRACTAL_MAX_REFERENCES 16
+
+// Glitched-pixel positions the shader records per frame for readback
+#define FRACTAL_MAX_GLITCH_SAMPLES 256
+
+// Per-frame march counters: pixels, full-resolution steps, steps skipped at the cone prepass's distance,
+// prepass steps, pixels started from reprojected history (MARCH_STAT_* in the shader, same order). The two
+// per-pixel step sums can pass 2^32 at high resolution, so they take (low, high) halves like the histogram totals.
+#define FRACTAL_NUM_MARCH_STATS 7
+
+// March histogram reduced from the per-pixel debug output: step buckets (linear up to MaxRaySteps), as many DE
+// iteration buckets (log2(1 + iterations) up to MaxRaySteps * MaxIterations), a pixel count per hit status
+// (none, hit, miss at MaxRayDistance, out of steps), then the step and DE iteration totals as (low, high) halves
+#define FRACTAL_MARCH_HISTOGRAM_BUCKETS 32
+#define FRACTAL_MARCH_HISTOGRAM_HIT_STATUSES 4
+#define FRACTAL_MARCH_HISTOGRAM_SIZE (2 * FRACTAL_MARCH_HISTOGRAM_BUCKETS + FRACTAL_MARCH_HISTOGRAM_HIT_STATUSES + 4)
+
 /**
  * Parameters for dispatching the perturbation shader
  */
@@ -109,17 +129,152 @@ public:
 		SHADER_PARAMETER(FVector3f, CameraOrigin)
 		SHADER_PARAMETER(FVector2f, ViewSize)
 		SHADER_PARAMETER(FVector2f, InvViewSize)
+		SHADER_PARAMETER(FVector2f, SampleJitter) // Sub-pixel ray offset of this accumulation sample, in [-0.5, 0.5)
 		SHADER_PARAMETER(FVector2f, BackgroundExtent)
 		SHADER_PARAMETER(FVector2f, BackgroundInvExtent)
 		SHADER_PARAMETER(FVector2f, BackgroundViewMin)
 		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, BackgroundTexture)
 		SHADER_PARAMETER_SAMPLER(SamplerState, BackgroundSampler)
 		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutputTexture)
+		SHADER_PARAMETER(int32, ComposeBackground) // 0: OutputTexture gets (fractal color, coverage) for FFractalUpscaleCS
 		// Perturbation orbit data
-		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, ReferenceOrbitTexture)
-		SHADER_PARAMETER_SAMPLER(SamplerState, OrbitSampler)
-		SHADER_PARAMETER(FVector3f, ReferenceCenter)
-		SHADER_PARAMETER(int32, OrbitLength)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float3>, ReferenceOrbitBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float3>, ReferenceDerivativeBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint2>, CompactOrbitBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, CompactOrbitBlockBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, CompactScaleBuffer)
+		SHADER_PARAMETER(int32, OrbitEncoding) // 0: float3 buffers, 1: FCompactOrbitEncoding
+		SHADER_PARAMETER_ARRAY(FVector4f, ReferenceCenters, [FRACTAL_MAX_REFERENCES]) // (C_0, orbit length) per row
+		SHADER_PARAMETER_ARRAY(FUintVector4, ReferenceOrbitOffsets, [FRACTAL_MAX_REFERENCES]) // (first buffer element, valid orbit length) per row
+		SHADER_PARAMETER(int32, NumReferences)
+		SHADER_PARAMETER(int32, OrbitHasDerivatives)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, SeriesApproximationBuffer)
+		SHADER_PARAMETER(int32, OrbitHasSeriesApproximation)
+		// Glitch counter and sample positions, read back to place secondary references
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, GlitchBuffer)
+		SHADER_PARAMETER(int32, MaxGlitchSamples)
+		// Previous frame's hit positions and camera, to start rays near last frame's surface
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, HistoryTexture)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, HistoryOutput)
+		SHADER_PARAMETER(FMatrix44f, PrevTranslatedWorldToClip)
+		SHADER_PARAMETER(FVector3f, PrevPreViewTranslation)
+		SHADER_PARAMETER(FIntPoint, HistorySize)
+		SHADER_PARAMETER(int32, HistoryValid)
+		SHADER_PARAMETER(float, ReprojectionBackOff)
+		SHADER_PARAMETER(float, DisocclusionThreshold)
+		// Cone prepass: (free distance, cone steps) per ConeTileSize tile, written by FFractalConeMarchCS
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float2>, ConeDepthTexture)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float2>, ConeDepthOutput)
+		SHADER_PARAMETER(FIntPoint, ConeDepthSize)
+		SHADER_PARAMETER(int32, ConeTileSize)
+		SHADER_PARAMETER(int32, ConeDepthValid)
+		// FRACTAL_NUM_MARCH_STATS counters shared by both passes, read back for stats
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, MarchStatsBuffer)
+		// Debug: (steps, DE iterations, hit status, cone steps skipped) per pixel for FFractalMarchHistogramCS
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<uint4>, MarchDebugOutput)
+		SHADER_PARAMETER(int32, MarchDebugOutputEnabled)
+		SHADER_PARAMETER(int32, HeatmapMode) // 0: shaded, 1: steps, 2: DE iterations, 3: hit status
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADS_X"), NUM_THREADS_PerturbationShader_X);
+		OutEnvironment.SetDefine(TEXT("THREADS_Y"), NUM_THREADS_PerturbationShader_Y);
+		OutEnvironment.SetDefine(TEXT("THREADS_Z"), NUM_THREADS_PerturbationShader_Z);
+		OutEnvironment.SetDefine(TEXT("MAX_REFERENCES"), FRACTAL_MAX_REFERENCES);
+		OutEnvironment.SetDefine(TEXT("SERIES_RADIUS_BUCKETS"), FOrbitSeriesApproximation::NumRadiusBuckets);
+		OutEnvironment.SetDefine(TEXT("SERIES_TEXELS_PER_BUCKET"), FOrbitSeriesApproximation::TexelsPerBucket);
+		OutEnvironment.SetDefine(TEXT("ORBIT_POINTS_PER_BLOCK"), FCompactOrbitEncoding::PointsPerBlock);
+		OutEnvironment.SetDefine(TEXT("NUM_MARCH_STATS"), FRACTAL_NUM_MARCH_STATS);
+	}
+};
+
+/**
+ * Low-resolution cone-march prepass of the perturbation shader (same source and parameters).
+ * Marches one cone per ConeTileSize tile and writes the distance every ray of the tile can skip.
+ */
+class FRACTALRENDERER_API FFractalConeMarchCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FFractalConeMarchCS);
+	using FParameters = FPerturbationComputeShader::FParameters;
+	SHADER_USE_PARAMETER_STRUCT(FFractalConeMarchCS, FGlobalShader);
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return FPerturbationComputeShader::ShouldCompilePermutation(Parameters);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FPerturbationComputeShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+	}
+};
+
+/**
+ * Depth-aware spatial upscale of a fractal marched below output resolution, composited over the scene color
+ */
+class FRACTALRENDERER_API FFractalUpscaleCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FFractalUpscaleCS);
+	SHADER_USE_PARAMETER_STRUCT(FFractalUpscaleCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(FIntPoint, OutputSize)
+		SHADER_PARAMETER(FIntPoint, InputSize)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutputTexture)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, FractalColorTexture) // (fractal color, coverage) at InputSize
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, FractalDepthTexture) // The march's hit history, (world position, code)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, BackgroundTexture)
+		SHADER_PARAMETER_SAMPLER(SamplerState, BackgroundSampler)
+		SHADER_PARAMETER(FVector2f, BackgroundInvExtent)
+		SHADER_PARAMETER(FVector2f, BackgroundViewMin)
+		SHADER_PARAMETER(FVector3f, CameraOrigin)
+		SHADER_PARAMETER(float, DepthSigma)
+		SHADER_PARAMETER(FVector2f, InputJitter) // SampleJitter of the march, in input texels
+		// Progressive refinement: running average of the composited samples at OutputSize
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, AccumulationTexture)
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, AccumulationOutput)
+		SHADER_PARAMETER(float, AccumulationWeight) // Weight of this frame's sample, 1 / (samples so far + 1)
+		SHADER_PARAMETER(int32, Accumulate) // 0: the resampled fractal is composited as is, 1: it is folded into the average first
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADS_X"), NUM_THREADS_PerturbationShader_X);
+		OutEnvironment.SetDefine(TEXT("THREADS_Y"), NUM_THREADS_PerturbationShader_Y);
+		OutEnvironment.SetDefine(TEXT("THREADS_Z"), NUM_THREADS_PerturbationShader_Z);
+	}
+};
+
+/**
+ * Reduces the march debug output to step and DE iteration histograms and hit status counts for readback
+ */
+class FRACTALRENDERER_API FFractalMarchHistogramCS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FFractalMarchHistogramCS);
+	SHADER_USE_PARAMETER_STRUCT(FFractalMarchHistogramCS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER(FIntPoint, InputSize)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<uint4>, MarchDebugTexture)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, HistogramBuffer) // FRACTAL_MARCH_HISTOGRAM_SIZE elements
+		SHADER_PARAMETER(int32, MaxRaySteps)
+		SHADER_PARAMETER(float, IterationBucketScale) // Buckets per unit of log2(1 + DE iterations)
 	END_SHADER_PARAMETER_STRUCT()
 
 	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
@@ -133,6 +288,8 @@ public:
 		OutEnvironment.SetDefine(TEXT("THREADS_X"), NUM_THREADS_PerturbationShader_X);
 		OutEnvironment.SetDefine(TEXT("THREADS_Y"), NUM_THREADS_PerturbationShader_Y);
 		OutEnvironment.SetDefine(TEXT("THREADS_Z"), NUM_THREADS_PerturbationShader_Z);
+		OutEnvironment.SetDefine(TEXT("HISTOGRAM_BUCKETS"), FRACTAL_MARCH_HISTOGRAM_BUCKETS);
+		OutEnvironment.SetDefine(TEXT("HISTOGRAM_HIT_STATUSES"), FRACTAL_MARCH_HISTOGRAM_HIT_STATUSES);
 	}
 };
 
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FractalParameter.h"
+#include "MandelbulbOrbitGenerator.h"
+#include "ReferenceOrbitCache.generated.h"
+
+/** Hit/miss counters and occupancy of the reference orbit cache, for sizing its budget. */
+USTRUCT(BlueprintType)
+struct FRACTALRENDERER_API FFractalOrbitCacheStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fractal|Orbit Cache")
+	int64 Hits = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fractal|Orbit Cache")
+	int64 Misses = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fractal|Orbit Cache")
+	int64 Evictions = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fractal|Orbit Cache")
+	int32 NumEntries = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fractal|Orbit Cache")
+	int64 UsedBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fractal|Orbit Cache")
+	int64 BudgetBytes = 0;
+};
+
+/**
+ * Identifies an orbit by its quantized inputs. The reference center is quantized on a
+ * power-of-two grid no coarser than the center-drift threshold at the current zoom, so any
+ * two centers in the same cell would not have triggered a regeneration relative to each other.
+ */
+struct FOrbitCacheKey
+{
+	int64 CenterX = 0;
+	int64 CenterY = 0;
+	int32 CenterExponent = 0;   // Grid cell size is 2^CenterExponent
+	int32 PowerMilli = 0;        // Power quantized to 1e-3
+	int32 BailoutMilli = 0;      // Bailout radius quantized to 1e-3
+	int32 MaxIterations = 0;
+	EFractalOrbitPrecision Precision = EFractalOrbitPrecision::Double;
+
+	/** Build a key for the orbit the given parameters would generate. */
+	static FOrbitCacheKey Make(const FFractalParameter& Params, double CenterCellSize, EFractalOrbitPrecision ResolvedPrecision);
+
+	bool operator==(const FOrbitCacheKey& Other) const
+	{
+		return CenterX == Other.CenterX
+			&& CenterY == Other.CenterY
+			&& CenterExponent == Other.CenterExponent
+			&& PowerMilli == Other.PowerMilli
+			&& BailoutMilli == Other.BailoutMilli
+			&& MaxIterations == Other.MaxIterations
+			&& Precision == Other.Precision;
+	}
+
+	/** Whether an orbit for Other differs from this one only in its iteration count, so it can be extended or truncated. */
+	bool MatchesExceptIterations(const FOrbitCacheKey& Other) const
+	{
+		FOrbitCacheKey Adjusted = Other;
+		Adjusted.MaxIterations = MaxIterations;
+		return *this == Adjusted;
+	}
+
+	friend uint32 GetTypeHash(const FOrbitCacheKey& Key)
+	{
+		uint32 Hash = GetTypeHash(Key.CenterX);
+		Hash = HashCombine(Hash, GetTypeHash(Key.CenterY));
+		Hash = HashCombine(Hash, GetTypeHash(Key.CenterExponent));
+		Hash = HashCombine(Hash, GetTypeHash(Key.PowerMilli));
+		Hash = HashCombine(Hash, GetTypeHash(Key.BailoutMilli));
+		Hash = HashCombine(Hash, GetTypeHash(Key.MaxIterations));
+		return HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.Precision)));
+	}
+};
+
+/**
+ * Memory-budgeted LRU cache of immutable reference orbits, owned by the game thread.
+ * Orbits are shared with the renderer, so a hit costs a pointer copy rather than a regeneration.
+ */
+class FRACTALRENDERER_API FReferenceOrbitCache
+{
+public:
+	using FOrbitRef = TSharedPtr<const FReferenceOrbit, ESPMode::ThreadSafe>;
+
+	/** Returns the cached orbit and marks it most recently used, or null on a miss. */
+	FOrbitRef Find(const FOrbitCacheKey& Key);
+
+	/** Insert (or refresh) an orbit, evicting least recently used entries to stay within budget. */
+	void Add(const FOrbitCacheKey& Key, FOrbitRef Orbit);
+
+	/** Change the memory budget; shrinking evicts immediately. */
+	void SetBudgetBytes(SIZE_T InBudgetBytes);
+
+	/** Drop every entry (counters are kept). */
+	void Empty();
+
+	FFractalOrbitCacheStats GetStats() const;
+
+private:
+	struct FEntry
+	{
+		FOrbitRef Orbit;
+		SIZE_T Bytes = 0;
+		uint64 LastUsed = 0;
+	};
+
+	void EvictToBudget();
+
+	TMap<FOrbitCacheKey, FEntry> Entries;
+	uint64 UseCounter = 0;
+	SIZE_T BudgetBytes = 0;
+	SIZE_T UsedBytes = 0;
+	int64 Hits = 0;
+	int64 Misses = 0;
+	int64 Evictions = 0;
+};
@@ -16,7 +16,7 @@ public class FractalGame : ModuleRules
 			"InputCore",
 		});
 
-		PrivateDependencyModuleNames.AddRange(new string[] { "RenderCore", "RHI" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "RenderCore", "RHI", "FractalRenderer" });
 
 		// Uncomment to add subdirectories to include paths
 		// PublicIncludePaths.AddRange(new string[] {
@@ -4,6 +4,18 @@
 #include "Engine/Engine.h"
 #include "Engine/Font.h"
 #include "CanvasItem.h"
+#include "Engine/GameInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "FractalControlSubsystem.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarHUDStats(
+		TEXT("Fractal.HUD.Stats"),
+		0,
+		TEXT("Draw the fractal pipeline timings (orbit generation, render thread, upload, GPU) under the position readout."),
+		ECVF_Default);
+}
 
 void AFractalHUD::DrawHUD()
 {
@@ -53,4 +65,24 @@ void AFractalHUD::DrawHUD()
 		DrawLine(Line, CurrentY);
 		CurrentY += LineSpacing;
 	}
+
+	const UGameInstance* GameInstance = GetGameInstance();
+	const UFractalControlSubsystem* FractalControl = GameInstance ? GameInstance->GetSubsystem<UFractalControlSubsystem>() : nullptr;
+	if (CVarHUDStats.GetValueOnGameThread() != 0 && FractalControl)
+	{
+		const FFractalPipelineStats& Stats = FractalControl->GetPipelineStats();
+		const FString StatsLines[] = {
+			FString::Printf(TEXT("Orbit %d pts, %d refs, %.1f regen/s"), Stats.OrbitLength, Stats.NumReferences, Stats.OrbitRegenerationsPerSecond),
+			FString::Printf(TEXT("Orbit gen %.2f ms, pack %.2f ms"), Stats.OrbitGenerationMs, Stats.OrbitPackingMs),
+			FString::Printf(TEXT("Render thread %.3f ms (lock %.3f ms), upload %.1f KB"), Stats.RenderThreadMs, Stats.LockWaitMs, Stats.UploadBytes / 1024.0f),
+			FString::Printf(TEXT("GPU %.2f ms, %.1f steps/px, quality %.2f"), Stats.GpuMs, Stats.StepsPerPixel, Stats.GovernorQuality),
+		};
+
+		CurrentY += LineSpacing * 0.5f;
+		for (const FString& Line : StatsLines)
+		{
+			DrawLine(Line, CurrentY);
+			CurrentY += LineSpacing;
+		}
+	}
 }